@@ -1,35 +1,81 @@
-QT       += core gui multimedia multimediawidgets
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-CONFIG += c++17
-
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    button.cpp \
-    main.cpp \
-    mainwindow.cpp \
-    mySlider.cpp \
-    player.cpp \
-    tomeo_ui.cpp
-
-HEADERS += \
-    button.h \
-    mainwindow.h \
-    mySlider.h \
-    player.h \
-    tomeo_ui.h
-
-FORMS += \
-    mainwindow.ui
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
-
-RESOURCES += \
-    icons/Tomeo_icons.qrc
+QT       += core gui multimedia multimediawidgets network
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+CONFIG += c++17
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    avatarCache.cpp \
+    commentFilter.cpp \
+    commentIngest.cpp \
+    commentItemDelegate.cpp \
+    commentListModel.cpp \
+    commentRenderer.cpp \
+    commentStore.cpp \
+    commentTrack.cpp \
+    danmakuOverlay.cpp \
+    main.cpp \
+    mainwindow.cpp \
+    mediaCatalogue.cpp \
+    mediaIndexer.cpp \
+    mediaLibrary.cpp \
+    mediaPrefetcher.cpp \
+    mediaProbe.cpp \
+    mediaScanner.cpp \
+    mySlider.cpp \
+    player.cpp \
+    playerPool.cpp \
+    scrubPreviewer.cpp \
+    searchIndex.cpp \
+    seekScheduler.cpp \
+    thumbnailCache.cpp \
+    thumbnailLoader.cpp \
+    thumbnailPrefetcher.cpp \
+    tomeo_ui.cpp \
+    videoItemDelegate.cpp \
+    videoListModel.cpp
+
+HEADERS += \
+    avatarCache.h \
+    commentFilter.h \
+    commentIngest.h \
+    commentItemDelegate.h \
+    commentListModel.h \
+    commentRenderer.h \
+    commentStore.h \
+    commentTrack.h \
+    danmakuOverlay.h \
+    mainwindow.h \
+    mediaCatalogue.h \
+    mediaIndexer.h \
+    mediaLibrary.h \
+    mediaPrefetcher.h \
+    mediaProbe.h \
+    mediaScanner.h \
+    mySlider.h \
+    player.h \
+    playerPool.h \
+    scrubPreviewer.h \
+    searchIndex.h \
+    seekScheduler.h \
+    thumbnailCache.h \
+    thumbnailLoader.h \
+    thumbnailPrefetcher.h \
+    tomeo_ui.h \
+    videoItemDelegate.h \
+    videoListModel.h
+
+FORMS += \
+    mainwindow.ui
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
+
+RESOURCES += \
+    icons/Tomeo_icons.qrc
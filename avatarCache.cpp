@@ -0,0 +1,64 @@
+#include "avatarCache.h"
+#include <QMutexLocker>
+
+namespace {
+
+const int defaultBudgetKb = 8 * 1024;  // Hundreds of avatars at panel size
+
+}
+
+AvatarCache &AvatarCache::shared()
+{
+    static AvatarCache cache;
+    return cache;
+}
+
+AvatarCache::AvatarCache()
+{
+    images.setMaxCost(defaultBudgetKb);
+
+    int budgetMb = qEnvironmentVariableIntValue("TOMEO_AVATAR_CACHE_MB");
+    if (budgetMb > 0) {
+        setMemoryBudget(qint64(budgetMb) * 1024 * 1024);
+    }
+}
+
+QImage AvatarCache::image(const QString &path, int side, qreal devicePixelRatio)
+{
+    QString key = QString("%1@%2x%3").arg(path).arg(side).arg(devicePixelRatio);
+    {
+        QMutexLocker locker(&mutex);
+        QImage *cached = images.object(key);
+        if (cached) {
+            hits++;
+            return *cached;
+        }
+        misses++;
+    }
+
+    // Decoded outside the lock, so other threads are not held up; two threads missing the same avatar at once both decode it
+    QImage scaled = QImage(path).scaled(QSize(side, side) * devicePixelRatio, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    scaled.setDevicePixelRatio(devicePixelRatio);
+
+    QMutexLocker locker(&mutex);
+    images.insert(key, new QImage(scaled), qMax(1, int(scaled.sizeInBytes() / 1024)));
+    return scaled;
+}
+
+void AvatarCache::setMemoryBudget(qint64 bytes)
+{
+    QMutexLocker locker(&mutex);
+    images.setMaxCost(int(qMax<qint64>(1, bytes / 1024)));
+}
+
+int AvatarCache::hitCount() const
+{
+    QMutexLocker locker(&mutex);
+    return hits;
+}
+
+int AvatarCache::missCount() const
+{
+    QMutexLocker locker(&mutex);
+    return misses;
+}
@@ -0,0 +1,41 @@
+#ifndef AVATARCACHE_H
+#define AVATARCACHE_H
+
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QString>
+
+// AvatarCache decodes every avatar image once per size and screen density and hands
+// the scaled result to whoever draws it, so a panel full of comments by the same few
+// people decodes a handful of files in all. There is one cache for the whole process;
+// it may be used from any thread, and images are evicted least recently used first
+// beyond a memory cap.
+class AvatarCache
+{
+public:
+    // The cache shared by the whole process
+    static AvatarCache &shared();
+
+    // The avatar at the given path fitted into a square of the given side, for the given
+    // device pixel ratio; a null image if the file cannot be read
+    QImage image(const QString &path, int side, qreal devicePixelRatio);
+
+    // Memory the scaled avatars may use. Defaults to TOMEO_AVATAR_CACHE_MB when set.
+    void setMemoryBudget(qint64 bytes);
+
+    // Lookups served from the cache, and those that had to decode the file
+    int hitCount() const;
+    int missCount() const;
+
+private:
+    // Constructor: reads the memory cap from the environment
+    AvatarCache();
+
+    mutable QMutex mutex;            // Guards everything below
+    QCache<QString, QImage> images;  // Scaled avatars by path, size and density; cost in KB
+    int hits = 0;                    // Lookups served from the cache
+    int misses = 0;                  // Lookups that decoded the file
+};
+
+#endif // AVATARCACHE_H
@@ -0,0 +1,184 @@
+#include "commentFilter.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QStandardPaths>
+#include <algorithm>
+#include <atomic>
+#include <map>
+
+// Compiles a word list and swaps it into the filter; runs on the filter's pool
+class FilterCompileTask : public QRunnable
+{
+public:
+    FilterCompileTask(CommentFilter *filter, const QStringList &words)
+        : filter(filter), words(words) {}
+
+    void run() override
+    {
+        std::shared_ptr<const CommentFilter::Automaton> compiled = std::make_shared<CommentFilter::Automaton>(words);
+        std::atomic_store(&filter->automaton, compiled);
+    }
+
+private:
+    CommentFilter *filter;  // Filter that takes the new automaton
+    QStringList words;      // Words to block
+};
+
+CommentFilter::CommentFilter(QObject *parent)
+    : QObject(parent)
+{
+    pool.setMaxThreadCount(1);  // Compiles finish in the order the lists were set
+
+    // The directory is watched too, so a file that is created, or replaced by an editor, is noticed
+    connect(&watcher, &QFileSystemWatcher::fileChanged, this, &CommentFilter::reload);
+    connect(&watcher, &QFileSystemWatcher::directoryChanged, this, &CommentFilter::reload);
+    reload();
+    pool.waitForDone();  // The first list is in place before any comment is checked
+}
+
+CommentFilter::~CommentFilter()
+{
+    pool.waitForDone();  // A running compile still references this filter
+}
+
+bool CommentFilter::blocks(const QString &text) const
+{
+    std::shared_ptr<const Automaton> current = std::atomic_load(&automaton);
+    return current && current->matches(text);
+}
+
+bool CommentFilter::isActive() const
+{
+    std::shared_ptr<const Automaton> current = std::atomic_load(&automaton);
+    return current && !current->isEmpty();
+}
+
+void CommentFilter::setWords(const QStringList &words)
+{
+    pool.start(new FilterCompileTask(this, words));
+}
+
+QString CommentFilter::wordFilePath()
+{
+    QString path = qEnvironmentVariable("TOMEO_BLOCKED_WORDS");
+    if (!path.isEmpty()) {
+        return QFileInfo(path).absoluteFilePath();
+    }
+    return QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) + "/blocked-words.txt";
+}
+
+void CommentFilter::reload()
+{
+    QString path = wordFilePath();
+    QString folder = QFileInfo(path).absolutePath();
+    if (QFileInfo::exists(folder) && !watcher.directories().contains(folder)) {
+        watcher.addPath(folder);
+    }
+    if (QFileInfo::exists(path) && !watcher.files().contains(path)) {
+        watcher.addPath(path);
+    }
+
+    // One word or phrase per line; blank lines and lines starting with '#' are skipped
+    QStringList words;
+    QFile file(path);
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!file.atEnd()) {
+            QString line = QString::fromUtf8(file.readLine()).trimmed();
+            if (!line.isEmpty() && !line.startsWith('#')) {
+                words.append(line);
+            }
+        }
+    }
+    setWords(words);
+}
+
+CommentFilter::Automaton::Automaton(const QStringList &words)
+{
+    // The trie of every word, with each state's edges in a map while it is built
+    std::vector<std::map<ushort, int>> children(1);
+    terminal.assign(1, false);
+    for (const QString &word : words) {
+        int state = 0;
+        for (QChar character : word) {
+            ushort folded = QChar::toCaseFolded(character.unicode());
+            auto next = children[state].find(folded);
+            if (next == children[state].end()) {
+                children.emplace_back();
+                terminal.push_back(false);
+                next = children[state].emplace(folded, int(children.size()) - 1).first;
+            }
+            state = next->second;
+        }
+        if (state != 0) {
+            terminal[state] = true;
+        }
+    }
+
+    // Flattened into one sorted edge array, so matching follows plain indices
+    int states = int(children.size());
+    firstEdge.resize(size_t(states) + 1);
+    for (int state = 0; state < states; ++state) {
+        firstEdge[state] = int(edges.size());
+        for (const auto &child : children[state]) {
+            edges.push_back(Edge{child.first, child.second});
+        }
+    }
+    firstEdge[states] = int(edges.size());
+
+    // Failure links breadth first, so the link of every shorter state is known before it is needed.
+    // A state is terminal if any word ends in it or in one of its suffixes, so matching only checks one flag.
+    failure.assign(size_t(states), 0);
+    std::vector<int> queue;
+    for (int e = firstEdge[0]; e < firstEdge[1]; ++e) {
+        queue.push_back(edges[e].target);
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int state = queue[head];
+        for (int e = firstEdge[state]; e < firstEdge[state + 1]; ++e) {
+            int target = edges[e].target;
+            failure[target] = step(failure[state], edges[e].character);
+            terminal[target] = terminal[target] || terminal[failure[target]];
+            queue.push_back(target);
+        }
+    }
+}
+
+bool CommentFilter::Automaton::matches(const QString &text) const
+{
+    if (isEmpty()) {
+        return false;
+    }
+
+    int state = 0;
+    for (QChar character : text) {
+        state = step(state, QChar::toCaseFolded(character.unicode()));
+        if (terminal[state]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int CommentFilter::Automaton::step(int state, ushort character) const
+{
+    while (true) {
+        int target = edge(state, character);
+        if (target >= 0) {
+            return target;
+        }
+        if (state == 0) {
+            return 0;
+        }
+        state = failure[state];
+    }
+}
+
+int CommentFilter::Automaton::edge(int state, ushort character) const
+{
+    auto begin = edges.begin() + firstEdge[state];
+    auto end = edges.begin() + firstEdge[state + 1];
+    auto found = std::lower_bound(begin, end, character,
+                                  [](const Edge &edge, ushort character) { return edge.character < character; });
+    return found != end && found->character == character ? found->target : -1;
+}
@@ -0,0 +1,86 @@
+#ifndef COMMENTFILTER_H
+#define COMMENTFILTER_H
+
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <memory>
+#include <vector>
+
+// CommentFilter keeps comments containing a blocked word away from the overlay and the
+// comment panel. The word list is compiled into one Aho-Corasick automaton, so a comment
+// is checked in a single pass over its characters however many words are blocked;
+// matching ignores case and finds words inside longer ones too. The list is read from
+// the file named by TOMEO_BLOCKED_WORDS, or blocked-words.txt in the configuration
+// folder, one word per line, and read again whenever the file changes. A new automaton
+// is compiled in the background and swapped in atomically: checks running on any
+// thread meanwhile finish with the old one and never wait.
+class CommentFilter : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Constructor: compiles the word list file in the background and watches it
+    explicit CommentFilter(QObject *parent = nullptr);
+
+    // Destructor: waits for a compile still running
+    ~CommentFilter();
+
+    // Whether the text contains a blocked word; safe to call from any thread
+    bool blocks(const QString &text) const;
+
+    // Whether any word is blocked at all, so texts are worth checking; safe to call from any thread
+    bool isActive() const;
+
+    // Block exactly the given words from now on, once they are compiled
+    void setWords(const QStringList &words);
+
+    // Location of the word list file
+    static QString wordFilePath();
+
+private:
+    friend class FilterCompileTask;
+
+    // The compiled word list
+    class Automaton
+    {
+    public:
+        // Build the automaton of the given words
+        explicit Automaton(const QStringList &words);
+
+        // Whether any word occurs in the text
+        bool matches(const QString &text) const;
+
+        // Whether there are no words, so nothing matches
+        bool isEmpty() const { return edges.empty(); }
+
+    private:
+        // A goto transition of the trie
+        struct Edge {
+            ushort character;    // Case-folded UTF-16 unit the edge is taken on
+            int target;          // State it leads to
+        };
+
+        // State reached from the given one on a character, following failure links; state 0 is the root
+        int step(int state, ushort character) const;
+
+        // Goto transition of a state on a character, or -1 if there is none
+        int edge(int state, ushort character) const;
+
+        std::vector<int> firstEdge;   // Start of every state's edges in edges, plus one past the end
+        std::vector<Edge> edges;      // Edges of every state, sorted by character
+        std::vector<int> failure;     // Longest proper suffix state of every state
+        std::vector<bool> terminal;   // Whether a word ends in the state, or in one of its suffixes
+    };
+
+    // Read the word list file and compile it in the background
+    void reload();
+
+    std::shared_ptr<const Automaton> automaton;  // Read and replaced with atomic operations only
+    QFileSystemWatcher watcher;                  // Notices edits of the word list file
+    QThreadPool pool;                            // Compiles new word lists
+};
+
+#endif // COMMENTFILTER_H
@@ -0,0 +1,227 @@
+#include "commentIngest.h"
+#include "commentFilter.h"
+#include <QDebug>
+#include <QList>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QMutexLocker>
+
+namespace {
+
+const int maxQueued = 5000;               // Comments waiting for the GUI before the sockets are left unread
+const int perFrame = 1000;                // Comments handed to the GUI per frame at most
+const int frameMs = 16;                   // How long comments wait to be batched into one frame
+const qint64 readBufferBytes = 64 * 1024; // Unread input held per socket; beyond it the sender blocks
+const int maxLineBytes = 4096;            // Longer lines are cut off; nobody reads a comment that long
+const int probeTimeoutMs = 200;           // How long a server already on the socket name gets to answer
+
+}
+
+// Accepts the connections and parses their lines; lives on the ingest's thread
+class IngestWorker : public QObject
+{
+public:
+    explicit IngestWorker(CommentIngest *ingest)
+        : ingest(ingest) {}
+
+    // Start accepting connections on the given name, replacing a server left behind by a crash
+    // but never one another running player is still listening on
+    void listen(const QString &name)
+    {
+        server = new QLocalServer(this);
+        if (!server->listen(name) && server->serverError() == QAbstractSocket::AddressInUseError) {
+            QLocalSocket probe;
+            probe.connectToServer(name);
+            if (!probe.waitForConnected(probeTimeoutMs)) {
+                QLocalServer::removeServer(name);  // Nobody answers; the socket file is stale
+                server->listen(name);
+            }
+        }
+        if (!server->isListening()) {
+            qDebug() << "Warning: live comments cannot be received on" << name << ":" << server->errorString();
+            return;
+        }
+        connect(server, &QLocalServer::newConnection, this, [this]() {
+            while (QLocalSocket *socket = server->nextPendingConnection()) {
+                socket->setReadBufferSize(readBufferBytes);
+                sockets.append(socket);
+                connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+                    read(socket);
+                });
+                connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+                    sockets.removeOne(socket);
+                    socket->deleteLater();
+                });
+            }
+        });
+    }
+
+    // Read on after the GUI has made room in the queue
+    void resume()
+    {
+        for (QLocalSocket *socket : sockets) {
+            read(socket);
+        }
+    }
+
+    // Close every connection and the server
+    void stop()
+    {
+        qDeleteAll(sockets);
+        sockets.clear();
+        delete server;
+        server = nullptr;
+    }
+
+private:
+    // Parse every complete line of a socket, as long as the queue has room; the rest waits in the socket until resume()
+    void read(QLocalSocket *socket)
+    {
+        while ((socket->canReadLine() || socket->bytesAvailable() >= maxLineBytes) && ingest->hasRoom()) {
+            QByteArray line = socket->readLine(maxLineBytes).trimmed();
+            if (line.isEmpty()) {
+                continue;
+            }
+
+            CommentIngest::Message message;
+            int tab = line.indexOf('\t');
+            if (tab >= 0) {
+                message.author = QString::fromUtf8(line.constData(), tab).trimmed();
+                message.text = QString::fromUtf8(line.constData() + tab + 1, line.size() - tab - 1).trimmed();
+            } else {
+                message.text = QString::fromUtf8(line);
+            }
+            if (message.author.isEmpty()) {
+                message.author = "Live";
+            }
+            if (!message.text.isEmpty()) {
+                ingest->enqueue(message);
+            }
+        }
+    }
+
+    CommentIngest *ingest;              // Ingest the comments are queued on
+    QLocalServer *server = nullptr;     // Accepts the connections
+    QList<QLocalSocket *> sockets;      // Open connections
+};
+
+CommentIngest::CommentIngest(const CommentFilter *filter, QObject *parent)
+    : QObject(parent),
+    filter(filter),
+    worker(new IngestWorker(this))
+{
+    frameTimer.setSingleShot(true);
+    frameTimer.setInterval(frameMs);
+    connect(&frameTimer, &QTimer::timeout, this, &CommentIngest::drain);
+
+    worker->moveToThread(&thread);
+    connect(&thread, &QThread::finished, worker, &QObject::deleteLater);
+    thread.start();
+
+    IngestWorker *reader = worker;
+    QString name = serverName();
+    QMetaObject::invokeMethod(worker, [reader, name]() {
+        reader->listen(name);
+    }, Qt::QueuedConnection);
+}
+
+CommentIngest::~CommentIngest()
+{
+    IngestWorker *reader = worker;
+    QMetaObject::invokeMethod(worker, [reader]() {
+        reader->stop();
+    }, Qt::BlockingQueuedConnection);
+    thread.quit();
+    thread.wait();
+}
+
+int CommentIngest::mergedCount() const
+{
+    QMutexLocker locker(&mutex);
+    return merged;
+}
+
+int CommentIngest::blockedCount() const
+{
+    QMutexLocker locker(&mutex);
+    return blocked;
+}
+
+QString CommentIngest::serverName()
+{
+    QString name = qEnvironmentVariable("TOMEO_INGEST_SERVER");
+    return name.isEmpty() ? QString("tomeo-comments") : name;
+}
+
+bool CommentIngest::hasRoom()
+{
+    // Only this thread adds to the queue, so the room is still there when the comment comes
+    QMutexLocker locker(&mutex);
+    paused = queue.size() >= maxQueued;
+    return !paused;
+}
+
+void CommentIngest::enqueue(const Message &message)
+{
+    // Checked before taking the lock, so the GUI thread never waits for a scan
+    bool blocks = filter->blocks(message.text);
+    QMutexLocker locker(&mutex);
+    if (blocks) {
+        blocked++;
+        return;
+    }
+
+    // The same words from many viewers at once become one comment with a count
+    auto waiting = queued.constFind(message.text);
+    if (waiting != queued.constEnd()) {
+        queue[int(*waiting - queueBase)].repeats++;
+        merged++;
+        return;
+    }
+
+    queued.insert(message.text, queueBase + queue.size());
+    queue.append(message);
+    if (!drainPending) {
+        drainPending = true;
+        QMetaObject::invokeMethod(this, [this]() {
+            if (!frameTimer.isActive()) {
+                frameTimer.start();
+            }
+        }, Qt::QueuedConnection);
+    }
+}
+
+void CommentIngest::drain()
+{
+    QVector<Message> batch;
+    bool resume = false;
+    {
+        QMutexLocker locker(&mutex);
+        int taken = qMin(perFrame, queue.size());
+        batch = queue.mid(0, taken);
+        queue.remove(0, taken);
+
+        // Only the taken texts leave the table; positions are counted from queueBase, so the rest stay valid
+        for (const Message &message : batch) {
+            queued.remove(message.text);
+        }
+        queueBase += taken;
+
+        resume = paused && queue.size() < maxQueued;
+        paused = paused && !resume;
+        drainPending = !queue.isEmpty();
+    }
+
+    if (resume) {
+        IngestWorker *reader = worker;
+        QMetaObject::invokeMethod(worker, [reader]() {
+            reader->resume();
+        }, Qt::QueuedConnection);
+    }
+    if (!batch.isEmpty()) {
+        emit messagesArrived(batch);
+    }
+    if (drainPending) {
+        frameTimer.start();  // The rest goes with the next frame
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef COMMENTINGEST_H
+#define COMMENTINGEST_H
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+
+class CommentFilter;
+class IngestWorker;
+
+// CommentIngest lets other programs stream live comments into the player through a
+// local socket, one UTF-8 line per comment: the author, a tab and the text, or just
+// the text. Sockets are read and lines parsed on a thread of their own. Parsed
+// comments wait in a bounded queue, where a comment identical to one already waiting
+// is merged into it instead of queued again; once the queue is full the sockets are
+// no longer read until the GUI has caught up, so senders are slowed down rather than
+// the window. The GUI thread takes the waiting comments once per frame, a bounded
+// batch at a time. Comments the filter blocks are dropped on the reading thread,
+// before they take up room in the queue. The socket name defaults to "tomeo-comments", or TOMEO_INGEST_SERVER
+// when set.
+class CommentIngest : public QObject
+{
+    Q_OBJECT
+
+public:
+    // One comment as it came in, with the number of identical ones merged into it
+    struct Message {
+        QString author;
+        QString text;
+        int repeats = 1;
+    };
+
+    // Constructor: starts the reading thread and listens on the socket.
+    // The filter is checked from the reading thread and must outlive the ingest.
+    explicit CommentIngest(const CommentFilter *filter, QObject *parent = nullptr);
+
+    // Destructor: closes every connection and stops the reading thread
+    ~CommentIngest();
+
+    // Comments merged into an identical waiting one so far
+    int mergedCount() const;
+
+    // Comments dropped because they contain a blocked word so far
+    int blockedCount() const;
+
+    // Name of the local socket comments are accepted on
+    static QString serverName();
+
+signals:
+    // Emitted on the GUI thread once per frame with the comments that came in since the last one
+    void messagesArrived(const QVector<CommentIngest::Message> &messages);
+
+private:
+    friend class IngestWorker;
+
+    // Called on the reading thread before a line is taken from a socket; returns false, and
+    // stops the reading until the GUI has made room, if the queue is full
+    bool hasRoom();
+
+    // Called on the reading thread with a parsed comment, after hasRoom() said there is room for it
+    void enqueue(const Message &message);
+
+    // Hand the next batch of waiting comments to the GUI
+    void drain();
+
+    const CommentFilter *filter;   // Decides which comments are dropped
+    QThread thread;                // Reads the sockets and parses the lines
+    IngestWorker *worker;          // Lives on that thread
+    QTimer frameTimer;             // Waits for the next frame once comments are waiting
+
+    mutable QMutex mutex;          // Guards everything below, which both threads use
+    QVector<Message> queue;        // Comments waiting for the GUI, oldest first
+    QHash<QString, qint64> queued; // Position of every waiting text, counted from the first comment ever queued, for merging
+    qint64 queueBase = 0;          // Position of the front of the queue in that count
+    int merged = 0;                // Comments merged into a waiting one
+    int blocked = 0;               // Comments dropped by the filter
+    bool drainPending = false;     // Whether the GUI has been told comments are waiting
+    bool paused = false;           // Whether the reading thread stopped reading because the queue was full
+};
+
+#endif // COMMENTINGEST_H
@@ -0,0 +1,133 @@
+#include "commentItemDelegate.h"
+#include "avatarCache.h"
+#include "commentListModel.h"
+#include <QApplication>
+#include <QDateTime>
+#include <QListView>
+#include <QPainter>
+#include <climits>
+
+namespace {
+
+const int cardMargin = 5;       // Space around the card of every row
+const int cardPadding = 15;     // Space between the card's edge and its contents
+const int cardRadius = 10;      // Rounding of the card's corners
+const int avatarSize = 80;      // Side of the square the avatar is fitted into
+const int spacing = 10;         // Gap between the avatar, the text and the posting time
+const int minTextHeight = 120;  // Short comments still get a roomy text area
+
+}
+
+CommentItemDelegate::CommentItemDelegate(QListView *view)
+    : QStyledItemDelegate(view),
+    view(view),
+    authorFont("Comic Sans MS"),
+    textFont("Comic Sans MS"),
+    postedFont("Comic Sans MS")
+{
+    authorFont.setPixelSize(36);
+    authorFont.setBold(true);
+    authorFont.setItalic(true);
+    textFont.setPixelSize(24);
+    postedFont.setPixelSize(16);
+
+    // Keep the remembered heights in step with the rows
+    QAbstractItemModel *model = view->model();
+    connect(model, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex &, int first, int last) {
+        if (first <= int(heights.size())) {
+            heights.insert(heights.begin() + first, last - first + 1, 0);
+        }
+    });
+    connect(model, &QAbstractItemModel::rowsRemoved, this, [this](const QModelIndex &, int first, int last) {
+        if (first < int(heights.size())) {
+            heights.erase(heights.begin() + first, heights.begin() + qMin(last + 1, int(heights.size())));
+        }
+    });
+    connect(model, &QAbstractItemModel::modelReset, this, [this]() {
+        heights.clear();
+    });
+}
+
+void CommentItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    // Let the style draw the row background, so the panel's stylesheet still decides the selection colour
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+    const QWidget *widget = opt.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &opt, painter, widget);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+
+    QRect card = option.rect.adjusted(cardMargin, cardMargin, -cardMargin, -cardMargin);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(QColor("#f0f0f0"));
+    painter->drawRoundedRect(card, cardRadius, cardRadius);
+    QRect content = card.adjusted(cardPadding, cardPadding, -cardPadding, -cardPadding);
+
+    // Avatar and author on top
+    QRect avatarRect(content.topLeft(), QSize(avatarSize, avatarSize));
+    QImage picture = AvatarCache::shared().image(index.data(CommentListModel::AvatarRole).toString(),
+                                                 avatarSize, view->devicePixelRatioF());
+    if (!picture.isNull()) {
+        QSize fitted = (QSizeF(picture.size()) / picture.devicePixelRatioF()).toSize();
+        QRect target(QPoint(0, 0), fitted);
+        target.moveCenter(avatarRect.center());
+        painter->drawImage(target, picture);
+    }
+
+    QRect authorRect(avatarRect.right() + spacing, content.top(), content.right() - avatarRect.right() - spacing, avatarSize);
+    painter->setFont(authorFont);
+    painter->setPen(QColor("#333333"));
+    QString author = QFontMetrics(authorFont).elidedText(index.data(CommentListModel::AuthorRole).toString(),
+                                                         Qt::ElideRight, authorRect.width());
+    painter->drawText(authorRect, Qt::AlignLeft | Qt::AlignVCenter, author);
+
+    // Posting time at the bottom, the comment in between
+    int postedHeight = QFontMetrics(postedFont).height();
+    QRect postedRect(content.left(), content.bottom() - postedHeight + 1, content.width(), postedHeight);
+    QRect textRect(content.left(), avatarRect.bottom() + 1 + spacing, content.width(),
+                   postedRect.top() - spacing - avatarRect.bottom() - 1 - spacing);
+
+    painter->setFont(textFont);
+    painter->setPen(QColor("#555555"));
+    painter->drawText(textRect, Qt::AlignLeft | Qt::AlignTop | Qt::TextWordWrap, index.data(Qt::DisplayRole).toString());
+
+    QDateTime posted = QDateTime::fromMSecsSinceEpoch(index.data(CommentListModel::PostedRole).toLongLong());
+    painter->setFont(postedFont);
+    painter->setPen(QColor("#999999"));
+    painter->drawText(postedRect, Qt::AlignLeft | Qt::AlignVCenter, posted.toString("yyyy-MM-dd HH:mm"));
+
+    painter->restore();
+}
+
+QSize CommentItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Q_UNUSED(option);
+
+    // Heights only hold for the width they were measured at
+    int width = view->viewport()->width();
+    if (width != measuredWidth) {
+        heights.assign(size_t(view->model()->rowCount()), 0);
+        measuredWidth = width;
+    }
+    if (index.row() >= int(heights.size())) {
+        heights.resize(size_t(index.row()) + 1, 0);
+    }
+
+    int &height = heights[index.row()];
+    if (height == 0) {
+        QRect bounds(0, 0, textWidth(width), INT_MAX);
+        int textHeight = QFontMetrics(textFont).boundingRect(bounds, Qt::TextWordWrap, index.data(Qt::DisplayRole).toString()).height();
+        height = 2 * (cardMargin + cardPadding) + avatarSize + spacing + qMax(minTextHeight, textHeight)
+                 + spacing + QFontMetrics(postedFont).height();
+    }
+    return QSize(width, height);
+}
+
+int CommentItemDelegate::textWidth(int rowWidth)
+{
+    return qMax(1, rowWidth - 2 * (cardMargin + cardPadding));
+}
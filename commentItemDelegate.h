@@ -0,0 +1,39 @@
+#ifndef COMMENTITEMDELEGATE_H
+#define COMMENTITEMDELEGATE_H
+
+#include <QFont>
+#include <QStyledItemDelegate>
+#include <vector>
+
+class QListView;
+
+// CommentItemDelegate paints one row of the comment panel: a rounded card with the
+// avatar and author on top, the wrapped comment text below and the posting time at
+// the bottom. Nothing is built per row, and avatars come from the shared AvatarCache.
+// Rows are as tall as their text needs, so each one is measured once at the panel's
+// width and the height is kept until the width changes; rows inserted or removed
+// shift the remembered heights along with them.
+class CommentItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    // Constructor: paints the rows of the given view, which must already have its model
+    explicit CommentItemDelegate(QListView *view);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    // Width available to the text of a card in a row of the given width
+    static int textWidth(int rowWidth);
+
+    QListView *view;                        // View whose rows are painted
+    QFont authorFont;                       // Font of the author name
+    QFont textFont;                         // Font of the comment text
+    QFont postedFont;                       // Font of the posting time
+    mutable std::vector<int> heights;       // Measured height of every row, 0 while unmeasured
+    mutable int measuredWidth = -1;         // Row width the heights were measured at
+};
+
+#endif // COMMENTITEMDELEGATE_H
@@ -0,0 +1,111 @@
+#include "commentListModel.h"
+
+namespace {
+
+const int fetchBatch = 200;  // Rows handed to the view at a time; a few screens of comments
+
+}
+
+CommentListModel::CommentListModel(CommentTrack *track, QObject *parent)
+    : QAbstractListModel(parent),
+    track(track)
+{
+}
+
+int CommentListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : fetched;
+}
+
+QVariant CommentListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return track->text(index.row());
+    case AuthorRole:
+        return track->author(index.row());
+    case AvatarRole:
+        return track->avatarPath(index.row());
+    case PostedRole:
+        return track->postedAt(index.row());
+    case TimeRole:
+        return track->timeAt(index.row());
+    default:
+        return QVariant();
+    }
+}
+
+bool CommentListModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && fetched < track->count();
+}
+
+void CommentListModel::fetchMore(const QModelIndex &parent)
+{
+    if (canFetchMore(parent)) {
+        fetchThrough(qMin(fetched + fetchBatch, track->count()) - 1);
+    }
+}
+
+int CommentListModel::addComments(const std::vector<CommentTrack::Comment> &comments)
+{
+    if (comments.empty()) {
+        return track->count();
+    }
+
+    int row = track->lowerBound(comments.front().time + 1);
+    if (row >= fetched && fetched < track->count()) {
+        return track->insertAll(comments);
+    }
+    int added = int(comments.size());
+    beginInsertRows(QModelIndex(), row, row + added - 1);
+    track->insertAll(comments);
+    fetched += added;
+    endInsertRows();
+    return row;
+}
+
+void CommentListModel::fetchThrough(int row)
+{
+    if (row < fetched) {
+        return;
+    }
+    beginInsertRows(QModelIndex(), fetched, row);
+    fetched = row + 1;
+    endInsertRows();
+}
+
+void CommentListModel::clear()
+{
+    beginResetModel();
+    track->clear();
+    fetched = 0;
+    endResetModel();
+}
+
+void CommentListModel::setTrack(CommentTrack &&replacement)
+{
+    beginResetModel();
+    *track = std::move(replacement);
+    fetched = qMin(fetchBatch, track->count());
+    endResetModel();
+}
+
+int CommentListModel::addComment(const CommentTrack::Comment &comment)
+{
+    // The track puts it after every comment with the same or an earlier time
+    int row = track->lowerBound(comment.time + 1);
+    if (row >= fetched && fetched < track->count()) {
+        track->insert(comment);  // Among the rows the view has not been handed yet
+        return row;
+    }
+    beginInsertRows(QModelIndex(), row, row);
+    track->insert(comment);
+    fetched++;
+    endInsertRows();
+    return row;
+}
@@ -0,0 +1,53 @@
+#ifndef COMMENTLISTMODEL_H
+#define COMMENTLISTMODEL_H
+
+#include "commentTrack.h"
+#include <QAbstractListModel>
+
+// CommentListModel exposes the comment track of the playing video to the comment
+// panel, one row per comment in playback-time order. Every change to the track goes
+// through the model, so the view only lays out and paints the rows that changed.
+// Rows are handed to the view a batch at a time as it scrolls down, so a track of a
+// million comments opens as fast as one of a hundred.
+class CommentListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    // Extra data roles read by the comment delegate
+    enum Roles {
+        AuthorRole = Qt::UserRole,  // Name of the commenter
+        AvatarRole,                 // Path of the commenter's avatar image
+        PostedRole,                 // When it was posted (ms since epoch)
+        TimeRole                    // Playback time the comment belongs to, in milliseconds
+    };
+
+    // Constructor: the model presents the given track, which must outlive it
+    CommentListModel(CommentTrack *track, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    // Forget every comment
+    void clear();
+
+    // Replace the whole track, e.g. with one just read from disk
+    void setTrack(CommentTrack &&replacement);
+
+    // Add a comment at its place in time and return its row
+    int addComment(const CommentTrack::Comment &comment);
+
+    // Add comments that share one time at their place and return the row of the first
+    int addComments(const std::vector<CommentTrack::Comment> &comments);
+
+    // Hand the view every row up to and including the given one
+    void fetchThrough(int row);
+
+private:
+    CommentTrack *track;  // The comments behind the rows
+    int fetched = 0;      // Comments handed to the view so far, from the first on
+};
+
+#endif // COMMENTLISTMODEL_H
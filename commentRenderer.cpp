@@ -0,0 +1,149 @@
+#include "commentRenderer.h"
+#include <QFont>
+#include <QFontMetrics>
+#include <QLinearGradient>
+#include <QPainter>
+#include <QRunnable>
+
+namespace {
+
+const int memoryBudgetKb = 32 * 1024;  // Rendered comments kept for reuse
+const int renderThreads = 2;           // Rendering is quick; two threads keep up with a busy stream
+const int fontPixelSize = 22;          // Size of the comment text
+const int paddingX = 15;               // Space left and right of the text inside the box
+const int paddingY = 10;               // Space above and below the text inside the box
+const int borderWidth = 2;             // Width of the box outline
+
+QFont commentFont()
+{
+    QFont font("Comic Sans MS");
+    font.setPixelSize(fontPixelSize);
+    return font;
+}
+
+}
+
+// Renders one comment; runs on the renderer's pool
+class CommentRenderTask : public QRunnable
+{
+public:
+    CommentRenderTask(CommentRenderer *renderer, const QString &text, qreal ratio)
+        : renderer(renderer), text(text), ratio(ratio) {}
+
+    void run() override
+    {
+        QImage image = CommentRenderer::render(text, ratio);
+
+        CommentRenderer *target = renderer;
+        QString done = text;
+        qreal doneRatio = ratio;
+        QMetaObject::invokeMethod(renderer, [target, done, doneRatio, image]() {
+            target->finished(done, doneRatio, image);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    CommentRenderer *renderer;  // Renderer that receives the image
+    QString text;               // Comment to render
+    qreal ratio;                // Device pixel ratio to render for
+};
+
+CommentRenderer::CommentRenderer(QObject *parent)
+    : QObject(parent)
+{
+    pool.setMaxThreadCount(renderThreads);
+    images.setMaxCost(memoryBudgetKb);
+    height = QFontMetrics(commentFont()).height() + 2 * paddingY;
+}
+
+CommentRenderer::~CommentRenderer()
+{
+    cancelAll();
+    pool.waitForDone();  // Running renders still reference this renderer
+}
+
+QImage CommentRenderer::image(const QString &text) const
+{
+    QImage *cached = images.object(text);  // Marks it as recently used
+    return cached ? *cached : QImage();
+}
+
+void CommentRenderer::request(const QString &text)
+{
+    if (pending.contains(text) || images.contains(text)) {
+        return;
+    }
+    pending.insert(text);
+    queue.append(text);
+    dispatch();
+}
+
+void CommentRenderer::cancelAll()
+{
+    for (const QString &text : queue) {
+        pending.remove(text);
+    }
+    queue.clear();
+}
+
+void CommentRenderer::setDevicePixelRatio(qreal ratio)
+{
+    if (qFuzzyCompare(ratio, pixelRatio)) {
+        return;
+    }
+    pixelRatio = ratio;
+    images.clear();
+    pending.clear();  // Renders still running are for the old density and are dropped when they finish
+    for (const QString &text : queue) {
+        pending.insert(text);
+    }
+}
+
+void CommentRenderer::dispatch()
+{
+    while (running < pool.maxThreadCount() && !queue.isEmpty()) {
+        running++;
+        pool.start(new CommentRenderTask(this, queue.takeFirst(), pixelRatio));
+    }
+}
+
+void CommentRenderer::finished(const QString &text, qreal ratio, const QImage &image)
+{
+    running--;
+    if (qFuzzyCompare(ratio, pixelRatio)) {
+        pending.remove(text);
+        int costKb = qMax(1, int(image.sizeInBytes() / 1024));
+        images.insert(text, new QImage(image), costKb);
+        emit rendered(text);
+    }
+    dispatch();  // A worker has become free
+}
+
+QImage CommentRenderer::render(const QString &text, qreal ratio)
+{
+    // Comments fly on one line
+    QString line = text.simplified();
+    QFont font = commentFont();
+    QFontMetrics metrics(font);
+    QSize box(metrics.horizontalAdvance(line) + 2 * paddingX, metrics.height() + 2 * paddingY);
+
+    QImage image(box * ratio, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(ratio);
+    image.fill(Qt::transparent);
+
+    // Pink to light pink from the top left to the bottom right of the box
+    QLinearGradient background(0, 0, box.width(), box.height());
+    background.setColorAt(0, QColor(255, 105, 180, 200));
+    background.setColorAt(1, QColor(255, 182, 193, 180));
+
+    QPainter painter(&image);
+    painter.setPen(QPen(QColor(255, 105, 180, 200), borderWidth));
+    painter.setBrush(background);
+    qreal inset = borderWidth / 2.0;
+    painter.drawRect(QRectF(QPointF(0, 0), box).adjusted(inset, inset, -inset, -inset));
+
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+    painter.drawText(QPointF(paddingX, paddingY + metrics.ascent()), line);
+    return image;
+}
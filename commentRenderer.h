@@ -0,0 +1,68 @@
+#ifndef COMMENTRENDERER_H
+#define COMMENTRENDERER_H
+
+#include <QCache>
+#include <QImage>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+// CommentRenderer turns the text of a flying comment into a finished image: text
+// shaped once, with the gradient box and border already painted around it, so the
+// overlay only has to copy pixels every frame. Rendering runs on a small worker
+// pool; requests wait in a queue on the GUI side, in order, and finished images are
+// kept in a cache bounded by memory that drops the least recently used first.
+class CommentRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Constructor: creates the rendering pool
+    explicit CommentRenderer(QObject *parent = nullptr);
+
+    // Destructor: drops queued work and waits for running renders to finish
+    ~CommentRenderer();
+
+    // The finished image of a comment, or a null image while it is not in the cache
+    QImage image(const QString &text) const;
+
+    // Render a comment in the background, unless it is cached or already on its way
+    void request(const QString &text);
+
+    // Drop every request that has not been picked up by a worker yet
+    void cancelAll();
+
+    // Render for another screen density; cached images for the old one are dropped
+    void setDevicePixelRatio(qreal ratio);
+
+    // Height of every comment image, in device-independent pixels
+    int boxHeight() const { return height; }
+
+signals:
+    // Emitted on the GUI thread when the image of a comment has been added to the cache
+    void rendered(const QString &text);
+
+private:
+    friend class CommentRenderTask;
+
+    // Hand queued requests to idle workers
+    void dispatch();
+
+    // Called on the GUI thread when a worker has rendered a comment for the given density
+    void finished(const QString &text, qreal ratio, const QImage &image);
+
+    // Paint the box and text of a comment; safe to call from any thread
+    static QImage render(const QString &text, qreal ratio);
+
+    QThreadPool pool;                     // Worker threads used for rendering
+    int running = 0;                      // Renders handed to the pool and not finished yet
+    QList<QString> queue;                 // Comments not handed to a worker yet, in order
+    QSet<QString> pending;                // Comments queued or being rendered for the current density
+    mutable QCache<QString, QImage> images; // Finished images by text; cost in KB
+    qreal pixelRatio = 1.0;               // Device pixel ratio images are rendered for
+    int height;                           // Height of every image, in device-independent pixels
+};
+
+#endif // COMMENTRENDERER_H
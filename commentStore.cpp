@@ -0,0 +1,140 @@
+#include "commentStore.h"
+#include "commentFilter.h"
+#include <QRunnable>
+
+namespace {
+
+const int batchMs = 1000;         // Comments are written at most this long after they were posted
+const int compactAfter = 4096;    // Appended records a log may collect before it is rewritten in time order
+
+}
+
+// Opens the log of one video, compacting it first if it has collected many appends; runs on the store's thread
+class LogLoadTask : public QRunnable
+{
+public:
+    LogLoadTask(CommentStore *store, const QString &videoPath)
+        : store(store), filter(store->filter), videoPath(videoPath) {}
+
+    void run() override
+    {
+        std::shared_ptr<CommentTrack> track = std::make_shared<CommentTrack>();
+        QString filePath = CommentTrack::logFilePath(videoPath);
+        track->openLog(filePath);
+        int unsortedCount = track->unsortedCount();
+        if (unsortedCount > compactAfter && track->writeLog(filePath)) {
+            unsortedCount = 0;  // The track has let go of the old file and reads the compacted one
+        }
+
+        // Blocked comments are dropped from the index only, after compacting, so unblocking a word brings them back.
+        // That reads every text, so it is skipped while no word is blocked and the texts stay unread until shown.
+        const CommentFilter *blocked = filter;
+        if (blocked->isActive()) {
+            track->removeIf([blocked](const QString &text) { return blocked->blocks(text); });
+        }
+
+        CommentStore *target = store;
+        QString path = videoPath;
+        QMetaObject::invokeMethod(store, [target, path, track, unsortedCount]() {
+            target->loaded(path, track, unsortedCount);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    CommentStore *store;          // Store that hands out the track
+    const CommentFilter *filter;  // Decides which comments are left out
+    QString videoPath;            // Video whose log to open
+};
+
+// Appends a batch of records to the log of one video; runs on the store's thread
+class LogAppendTask : public QRunnable
+{
+public:
+    LogAppendTask(const QString &videoPath, const QByteArray &records)
+        : videoPath(videoPath), records(records) {}
+
+    void run() override
+    {
+        CommentTrack::appendToLog(CommentTrack::logFilePath(videoPath), records);
+    }
+
+private:
+    QString videoPath;   // Video the comments belong to
+    QByteArray records;  // Encoded comments, in the order they were posted
+};
+
+// Rewrites the log of one video in time order; runs on the store's thread
+class LogCompactTask : public QRunnable
+{
+public:
+    explicit LogCompactTask(const QString &videoPath)
+        : videoPath(videoPath) {}
+
+    void run() override
+    {
+        QString filePath = CommentTrack::logFilePath(videoPath);
+        CommentTrack track;
+        if (track.openLog(filePath) && track.unsortedCount() > 0) {
+            track.writeLog(filePath);
+        }
+    }
+
+private:
+    QString videoPath;  // Video whose log to compact
+};
+
+CommentStore::CommentStore(const CommentFilter *filter, QObject *parent)
+    : QObject(parent),
+    filter(filter)
+{
+    pool.setMaxThreadCount(1);
+
+    batchTimer.setSingleShot(true);
+    batchTimer.setInterval(batchMs);
+    connect(&batchTimer, &QTimer::timeout, this, &CommentStore::flush);
+}
+
+CommentStore::~CommentStore()
+{
+    flush();
+    pool.waitForDone();  // Running loads still reference this store, and the last batch should reach the disk
+}
+
+void CommentStore::load(const QString &videoPath)
+{
+    flush();  // Whatever was posted on this video must be in the log it is about to read
+    unsorted[videoPath] = 0;  // Counted afresh from the log
+    pool.start(new LogLoadTask(this, videoPath));
+}
+
+void CommentStore::append(const QString &videoPath, const CommentTrack::Comment &comment)
+{
+    batches[videoPath].append(CommentTrack::encode(comment));
+    unsorted[videoPath]++;
+    if (!batchTimer.isActive()) {
+        batchTimer.start();
+    }
+}
+
+void CommentStore::flush()
+{
+    batchTimer.stop();
+    for (auto batch = batches.constBegin(); batch != batches.constEnd(); ++batch) {
+        pool.start(new LogAppendTask(batch.key(), batch.value()));
+
+        // Compacting runs after the append, on the same thread, so it sees the whole log
+        int &appended = unsorted[batch.key()];
+        if (appended > compactAfter) {
+            pool.start(new LogCompactTask(batch.key()));
+            appended = 0;
+        }
+    }
+    batches.clear();
+}
+
+void CommentStore::loaded(const QString &videoPath, const std::shared_ptr<CommentTrack> &track, int unsortedCount)
+{
+    // Comments posted while the log was being opened were appended after it and are not counted in it
+    unsorted[videoPath] += unsortedCount;
+    emit trackLoaded(videoPath, track);
+}
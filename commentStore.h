@@ -0,0 +1,59 @@
+#ifndef COMMENTSTORE_H
+#define COMMENTSTORE_H
+
+#include "commentTrack.h"
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <memory>
+
+class CommentFilter;
+
+// CommentStore keeps the comment log of every video, doing all file work on one
+// worker thread so neither opening a video with a long history nor posting a comment
+// ever waits for the disk. New comments are collected for a moment and appended to
+// their log in one write and one sync per batch. Once enough comments have been
+// appended to a log since it was last compacted, it is rewritten in time order, so
+// opening it again stays a straight pass over the mapping. Comments the filter blocks
+// are left out of the tracks it hands out, though they stay in the logs.
+class CommentStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Constructor: creates the worker thread. The filter is checked from that thread and must outlive the store.
+    explicit CommentStore(const CommentFilter *filter, QObject *parent = nullptr);
+
+    // Destructor: writes the last batch and waits for the worker
+    ~CommentStore();
+
+    // Open the log of a video in the background; trackLoaded() follows, with an empty track if there is none
+    void load(const QString &videoPath);
+
+    // Log a comment on a video; it is written with the next batch
+    void append(const QString &videoPath, const CommentTrack::Comment &comment);
+
+    // Hand every waiting comment to the worker now
+    void flush();
+
+signals:
+    // Emitted on the GUI thread with the track of a video that was asked for
+    void trackLoaded(const QString &videoPath, std::shared_ptr<CommentTrack> track);
+
+private:
+    friend class LogLoadTask;
+
+    // Called on the GUI thread when a log has been opened, with the records still waiting for compaction
+    void loaded(const QString &videoPath, const std::shared_ptr<CommentTrack> &track, int unsortedCount);
+
+    const CommentFilter *filter;           // Decides which comments are left out of loaded tracks
+    QThreadPool pool;                      // The single thread doing the file work, in order
+    QHash<QString, QByteArray> batches;    // Encoded comments waiting to be appended, by video
+    QHash<QString, int> unsorted;          // Records appended to each log since its last compaction
+    QTimer batchTimer;                     // Collects comments into batches
+};
+
+#endif // COMMENTSTORE_H
@@ -0,0 +1,373 @@
+#include "commentTrack.h"
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+#ifdef Q_OS_WIN
+#include <io.h>
+#include <windows.h>
+#endif
+
+namespace {
+
+const quint32 fileMagic = 0x544f4d4c;  // "TOML"
+const quint32 fileVersion = 1;         // Layout version of the header and records
+const quint64 poolBit = quint64(1) << 63;
+
+// Start of the log; in host byte order, since the log never leaves the machine
+struct LogHeader {
+    quint32 magic;
+    quint32 version;
+    quint64 sortedBytes;   // Bytes of records after the header that are in time order
+};
+
+// Start of every record, followed by the author, avatar path and text as UTF-16 and
+// zero padding up to a multiple of 8 bytes, so every record starts aligned
+struct RecordHeader {
+    quint32 size;          // Bytes of the whole record, padding included
+    quint16 checksum;      // CRC-16 of everything after this field, to spot torn appends
+    quint16 authorLength;  // Characters of the author name
+    quint16 avatarLength;  // Characters of the avatar path
+    quint16 reserved;
+    quint32 textLength;    // Characters of the text
+    qint64 time;           // Playback time in milliseconds
+    qint64 posted;         // When it was posted (ms since epoch)
+};
+
+static_assert(sizeof(LogHeader) == 16, "log header must be packed");
+static_assert(sizeof(RecordHeader) == 32, "record header must be packed");
+
+const int checksumOffset = 6;  // Where the checksummed part of a record starts
+
+RecordHeader headerAt(const uchar *record)
+{
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+    return header;
+}
+
+// Characters of the string that starts the given number of characters into the record's strings
+QString stringAt(const uchar *record, int skip, int length)
+{
+    const QChar *chars = reinterpret_cast<const QChar *>(record + sizeof(RecordHeader));
+    return QString(chars + skip, length);
+}
+
+// Whether a header describes a record that fits in the given number of bytes
+bool plausible(const RecordHeader &header, qint64 available)
+{
+    qint64 needed = qint64(sizeof(RecordHeader))
+                    + 2 * (qint64(header.authorLength) + header.avatarLength + header.textLength);
+    return header.size % 8 == 0 && header.size >= needed && header.size <= available;
+}
+
+}
+
+void CommentTrack::clear()
+{
+    entries.clear();
+    log.reset();
+    mapped = nullptr;
+    pool.clear();
+    unsorted = 0;
+}
+
+int CommentTrack::insert(const Comment &comment)
+{
+    quint64 ref = poolBit | quint64(pool.size());
+    pool.append(encode(comment));
+
+    // Comments posted at the same moment keep the order they came in
+    auto at = std::upper_bound(entries.begin(), entries.end(), comment.time,
+                               [](qint64 time, const Entry &entry) { return time < entry.time; });
+    int index = int(at - entries.begin());
+    entries.insert(at, Entry{comment.time, ref});
+    return index;
+}
+
+int CommentTrack::insertAll(const std::vector<Comment> &comments)
+{
+    if (comments.empty()) {
+        return count();
+    }
+
+    // One move of the index for the whole batch
+    qint64 time = comments.front().time;
+    std::vector<Entry> added;
+    added.reserve(comments.size());
+    for (const Comment &comment : comments) {
+        added.push_back(Entry{time, poolBit | quint64(pool.size())});
+        pool.append(encode(comment));
+    }
+    auto at = std::upper_bound(entries.begin(), entries.end(), time,
+                               [](qint64 time, const Entry &entry) { return time < entry.time; });
+    int index = int(at - entries.begin());
+    entries.insert(at, added.begin(), added.end());
+    return index;
+}
+
+QString CommentTrack::text(int index) const
+{
+    const uchar *data = record(index);
+    RecordHeader header = headerAt(data);
+    return stringAt(data, header.authorLength + header.avatarLength, int(header.textLength));
+}
+
+QString CommentTrack::author(int index) const
+{
+    const uchar *data = record(index);
+    return stringAt(data, 0, headerAt(data).authorLength);
+}
+
+QString CommentTrack::avatarPath(int index) const
+{
+    const uchar *data = record(index);
+    RecordHeader header = headerAt(data);
+    return stringAt(data, header.authorLength, header.avatarLength);
+}
+
+qint64 CommentTrack::postedAt(int index) const
+{
+    return headerAt(record(index)).posted;
+}
+
+CommentTrack::Comment CommentTrack::comment(int index) const
+{
+    const uchar *data = record(index);
+    RecordHeader header = headerAt(data);
+    Comment comment;
+    comment.time = header.time;
+    comment.author = stringAt(data, 0, header.authorLength);
+    comment.avatarPath = stringAt(data, header.authorLength, header.avatarLength);
+    comment.text = stringAt(data, header.authorLength + header.avatarLength, int(header.textLength));
+    comment.posted = header.posted;
+    return comment;
+}
+
+int CommentTrack::lowerBound(qint64 time) const
+{
+    auto at = std::lower_bound(entries.begin(), entries.end(), time,
+                               [](const Entry &entry, qint64 time) { return entry.time < time; });
+    return int(at - entries.begin());
+}
+
+int CommentTrack::removeIf(const std::function<bool(const QString &)> &predicate)
+{
+    // Time order is kept, so the index stays sorted
+    size_t kept = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (!predicate(text(int(i)))) {
+            entries[kept++] = entries[i];
+        }
+    }
+    int removed = int(entries.size() - kept);
+    entries.resize(kept);
+    return removed;
+}
+
+bool CommentTrack::openLog(const QString &filePath)
+{
+    clear();
+
+    std::shared_ptr<QFile> file = std::make_shared<QFile>(filePath);
+    if (!file->open(QIODevice::ReadWrite) || file->size() < qint64(sizeof(LogHeader))) {
+        return false;  // Nobody has commented on this video yet
+    }
+    qint64 size = file->size();
+    const uchar *data = file->map(0, size);
+    if (!data) {
+        return false;
+    }
+
+    LogHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != fileMagic || header.version != fileVersion
+            || header.sortedBytes > quint64(size) - sizeof(LogHeader)) {
+        qDebug() << "Warning: comment log " << filePath << " is not readable, ignoring it.";
+        return false;
+    }
+
+    // Index the records from pos up to end; stops at the first record that does not fit, or fails its checksum when asked to
+    auto scan = [&](qint64 pos, qint64 end, bool checked) {
+        while (end - pos >= qint64(sizeof(RecordHeader))) {
+            RecordHeader record = headerAt(data + pos);
+            if (!plausible(record, end - pos)
+                    || (checked && qChecksum(reinterpret_cast<const char *>(data + pos + checksumOffset),
+                                             record.size - checksumOffset) != record.checksum)) {
+                break;
+            }
+            entries.push_back(Entry{record.time, quint64(pos)});
+            pos += record.size;
+        }
+        return pos;
+    };
+
+    // The compacted part was written in one piece, so only record sizes are checked there
+    qint64 sortedEnd = qint64(sizeof(LogHeader) + header.sortedBytes);
+    bool damaged = scan(sizeof(LogHeader), sortedEnd, false) != sortedEnd;
+    if (damaged) {
+        // Keep the compacted records that still pass their checksum
+        entries.clear();
+        scan(sizeof(LogHeader), sortedEnd, true);
+    }
+    size_t sorted = entries.size();
+
+    // Appended records are checked in full; the first bad one is where a crash cut an append short
+    qint64 pos = scan(sortedEnd, size, true);
+    if (damaged) {
+        // Rewritten right away, so the damage is not met again on every open. The records are
+        // copied out first: the file is replaced under its old name, which fails while it is mapped.
+        for (Entry &entry : entries) {
+            const uchar *record = data + entry.ref;
+            entry.ref = poolBit | quint64(pool.size());
+            pool.append(reinterpret_cast<const char *>(record), int(headerAt(record).size));
+        }
+        file->unmap(const_cast<uchar *>(data));
+        file->close();
+        data = nullptr;
+        qDebug() << "Warning: comment log " << filePath << " is damaged, keeping " << entries.size() << " comments.";
+    } else if (pos < size) {
+        // Later appends must follow the last whole record. Files cannot shrink under a mapping everywhere.
+        file->unmap(const_cast<uchar *>(data));
+        data = file->resize(pos) ? file->map(0, pos) : nullptr;
+        if (!data) {
+            entries.clear();
+            return false;
+        }
+    }
+
+    // Appended comments are merged in by time; those with equal times keep their order
+    auto byTime = [](const Entry &a, const Entry &b) { return a.time < b.time; };
+    if (!std::is_sorted(entries.begin(), entries.begin() + sorted, byTime)) {
+        std::stable_sort(entries.begin(), entries.begin() + sorted, byTime);  // Not written by writeLog()
+    }
+    unsorted = int(entries.size() - sorted);
+    if (unsorted > 0) {
+        std::stable_sort(entries.begin() + sorted, entries.end(), byTime);
+        std::inplace_merge(entries.begin(), entries.begin() + sorted, entries.end(), byTime);
+    }
+
+    if (damaged) {
+        unsorted = 0;
+        if (!writeLog(filePath)) {
+            qDebug() << "Warning: could not rewrite comment log " << filePath;
+        }
+        return true;  // Served from the pool until the next open
+    }
+
+    log = file;
+    mapped = data;
+    return true;
+}
+
+bool CommentTrack::writeLog(const QString &filePath)
+{
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    // QSaveFile only replaces the old file once the new one is complete
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    LogHeader header{fileMagic, fileVersion, 0};
+    for (int i = 0; i < count(); ++i) {
+        header.sortedBytes += headerAt(record(i)).size;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (int i = 0; i < count(); ++i) {
+        const uchar *data = record(i);
+        file.write(reinterpret_cast<const char *>(data), headerAt(data).size);
+    }
+
+    bool replacesOwnLog = log && QFileInfo(log->fileName()) == QFileInfo(filePath);
+    if (!replacesOwnLog) {
+        return file.commit();
+    }
+    if (log.use_count() > 1) {
+        file.cancelWriting();  // A copy still reads the mapping
+        return false;
+    }
+    log->unmap(const_cast<uchar *>(mapped));
+    log->close();
+    bool written = file.commit();
+
+    // The new log if it was written, the old one if not; either way the track matches the disk again
+    openLog(filePath);
+    return written;
+}
+
+QByteArray CommentTrack::encode(const Comment &comment)
+{
+    QString author = comment.author.left(0xffff);
+    QString avatar = comment.avatarPath.left(0xffff);
+
+    RecordHeader header{};
+    header.authorLength = quint16(author.size());
+    header.avatarLength = quint16(avatar.size());
+    header.textLength = quint32(comment.text.size());
+    header.time = comment.time;
+    header.posted = comment.posted;
+    qint64 length = qint64(sizeof(header)) + 2 * (qint64(author.size()) + avatar.size() + comment.text.size());
+    header.size = quint32((length + 7) / 8 * 8);
+
+    QByteArray record(int(header.size), '\0');
+    char *out = record.data() + sizeof(header);
+    for (const QString *string : {&author, &avatar, &comment.text}) {
+        std::memcpy(out, string->constData(), size_t(string->size()) * 2);
+        out += string->size() * 2;
+    }
+    std::memcpy(record.data(), &header, sizeof(header));
+    header.checksum = qChecksum(record.constData() + checksumOffset, header.size - checksumOffset);
+    std::memcpy(record.data(), &header, sizeof(header));
+    return record;
+}
+
+bool CommentTrack::appendToLog(const QString &filePath, const QByteArray &records)
+{
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Append)) {
+        return false;
+    }
+    if (file.size() == 0) {
+        LogHeader header{fileMagic, fileVersion, 0};
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+    if (file.write(records) != records.size() || !file.flush()) {
+        return false;
+    }
+
+    // One sync per batch: the comments of the batch survive a crash or power loss from here on
+#if defined(Q_OS_UNIX)
+    return ::fsync(file.handle()) == 0;
+#elif defined(Q_OS_WIN)
+    return ::FlushFileBuffers(reinterpret_cast<HANDLE>(::_get_osfhandle(file.handle()))) != 0;
+#else
+    return true;
+#endif
+}
+
+QString CommentTrack::logFilePath(const QString &videoPath)
+{
+    QByteArray hash = QCryptographicHash::hash(videoPath.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/comments/" + QString::fromLatin1(hash) + ".log";
+}
+
+const uchar *CommentTrack::record(int index) const
+{
+    quint64 ref = entries[index].ref;
+    if (ref & poolBit) {
+        return reinterpret_cast<const uchar *>(pool.constData()) + (ref & ~poolBit);
+    }
+    return mapped + ref;
+}
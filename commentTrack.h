@@ -0,0 +1,115 @@
+#ifndef COMMENTTRACK_H
+#define COMMENTTRACK_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// CommentTrack holds the comments of one video, each pinned to the playback time it
+// was posted at, in time order. Comments are stored as records in the video's
+// append-only log: opening a track maps the log into memory and only builds a time
+// index over it, so the text of a comment is not read until it is shown or checked by
+// removeIf(), and even a million comments cost 16 bytes each in memory. Comments
+// added afterwards are encoded into an in-memory pool in the same record format.
+// Finding the comments due at a position is a binary search over the index.
+//
+// The log starts with a header naming how many bytes of records are in time order;
+// everything after them was appended since, in arrival order, and may end in a record
+// torn by a crash, which opening cuts off. Rewriting the log in time order compacts it.
+class CommentTrack
+{
+public:
+    // One comment as it is added and handed out
+    struct Comment {
+        qint64 time = 0;      // Playback time the comment belongs to, in milliseconds
+        QString author;       // Name of the commenter
+        QString text;         // The comment itself
+        QString avatarPath;   // Image shown next to the author
+        qint64 posted = 0;    // When it was posted (ms since epoch)
+    };
+
+    // Forget every comment and release the log
+    void clear();
+
+    // Add a comment after every comment with the same or an earlier time; returns its index
+    int insert(const Comment &comment);
+
+    // Add comments that share one time after every comment with the same or an earlier time,
+    // in the given order; returns the index of the first
+    int insertAll(const std::vector<Comment> &comments);
+
+    // Number of comments
+    int count() const { return static_cast<int>(entries.size()); }
+
+    // Whether the track has no comments
+    bool isEmpty() const { return entries.empty(); }
+
+    // Playback time of the comment at the given index, in milliseconds
+    qint64 timeAt(int index) const { return entries[index].time; }
+
+    // Text of the comment at the given index
+    QString text(int index) const;
+
+    // Author name of the comment at the given index
+    QString author(int index) const;
+
+    // Avatar path of the comment at the given index
+    QString avatarPath(int index) const;
+
+    // When the comment at the given index was posted (ms since epoch)
+    qint64 postedAt(int index) const;
+
+    // Everything about the comment at the given index
+    Comment comment(int index) const;
+
+    // Index of the first comment at or after the given playback time; count() if there is none
+    int lowerBound(qint64 time) const;
+
+    // Drop the comments whose text the predicate accepts; returns how many were dropped.
+    // Reads the text of every comment. Only the index changes: the log keeps them,
+    // unless the track writes it afterwards.
+    int removeIf(const std::function<bool(const QString &)> &predicate);
+
+    // Map a log and index its records, cutting off a torn last record. A damaged log keeps
+    // the records that still pass their checksum and is rewritten with only those. Returns
+    // false and leaves the track empty if there is no log or it is not one.
+    bool openLog(const QString &filePath);
+
+    // Records of the opened log that were appended after its last compaction
+    int unsortedCount() const { return unsorted; }
+
+    // Write every comment to a new log in time order, replacing the file atomically; returns false on failure.
+    // When that is the log the track has open, the track lets go of it before the file is replaced, since an
+    // open file cannot be replaced everywhere, and then reads the new one; copies of the track must be gone.
+    bool writeLog(const QString &filePath);
+
+    // One comment encoded as a log record
+    static QByteArray encode(const Comment &comment);
+
+    // Append encoded records to a log, creating it if needed, and wait until they are on disk
+    static bool appendToLog(const QString &filePath, const QByteArray &records);
+
+    // File the comments of a video are logged in
+    static QString logFilePath(const QString &videoPath);
+
+private:
+    // One comment of the index
+    struct Entry {
+        qint64 time;  // Playback time in milliseconds
+        quint64 ref;  // Offset of the record in the mapping, or in the pool when poolBit is set
+    };
+
+    // Start of the record of the comment at the given index
+    const uchar *record(int index) const;
+
+    std::vector<Entry> entries;          // Every comment, in time order
+    std::shared_ptr<QFile> log;          // The mapped log, shared with copies of the track
+    const uchar *mapped = nullptr;       // Start of the mapping, or null when no log is open
+    QByteArray pool;                     // Records of the comments added since the log was opened
+    int unsorted = 0;                    // Records of the log appended after its last compaction
+};
+
+#endif // COMMENTTRACK_H
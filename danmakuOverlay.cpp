@@ -0,0 +1,220 @@
+#include "danmakuOverlay.h"
+#include <QEvent>
+#include <QPainter>
+
+namespace {
+
+const int flightMs = 12000;        // Time a comment takes to cross the video
+const int frameMs = 16;            // Frame interval while anything is in flight
+const int laneSpacing = 4;         // Space between two lanes
+const int laneGap = 20;            // Least space between two comments in one lane
+const int layers = 32;             // Layers of lanes opened one after the other as the screen fills
+const int maxWaiting = 10000;      // Comments kept waiting for a lane; older ones are never dropped for newer
+const int renderAhead = 256;       // Waiting comments rendered ahead of their turn; more would only churn the cache
+
+}
+
+DanmakuOverlay::DanmakuOverlay(QWidget *video)
+    : QWidget(video),
+    video(video)
+{
+    // A see-through layer that never takes the mouse away from the video
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setGeometry(video->rect());
+    video->installEventFilter(this);
+
+    renderer.setDevicePixelRatio(devicePixelRatioF());
+    connect(&renderer, &CommentRenderer::rendered, this, &DanmakuOverlay::wake);
+
+    laneTails.assign(lanesPerLayer() * layers, -1);
+
+    frameTimer.setTimerType(Qt::PreciseTimer);
+    frameTimer.setInterval(frameMs);
+    connect(&frameTimer, &QTimer::timeout, this, &DanmakuOverlay::advance);
+    clock.start();
+
+    raise();
+    show();
+}
+
+void DanmakuOverlay::launch(const QString &text)
+{
+    // Comments keep their order: nothing overtakes the queue
+    if (!waiting.isEmpty() || !tryLaunch(text)) {
+        if (waiting.size() < maxWaiting) {
+            if (waiting.size() < renderAhead) {
+                renderer.request(text);
+            }
+            waiting.enqueue(text);
+        } else {
+            dropped++;
+        }
+    }
+    wake();
+}
+
+void DanmakuOverlay::clear()
+{
+    bullets.clear();
+    live.clear();
+    freeSlots = -1;
+    std::fill(laneTails.begin(), laneTails.end(), -1);
+    waiting.clear();
+    renderer.cancelAll();
+    update();
+}
+
+void DanmakuOverlay::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    for (int index : live) {
+        const Bullet &bullet = bullets[index];
+        painter.drawImage(QPointF(bullet.x, bullet.top), bullet.image);
+    }
+}
+
+bool DanmakuOverlay::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == video && event->type() == QEvent::Resize) {
+        int perLayer = lanesPerLayer();
+        setGeometry(video->rect());
+        renderer.setDevicePixelRatio(devicePixelRatioF());
+
+        // A new height puts every lane number on another row, so the lanes start out empty;
+        // comments in flight stay where they are and are no lane's tail any more
+        if (lanesPerLayer() != perLayer) {
+            laneTails.assign(lanesPerLayer() * layers, -1);
+        }
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void DanmakuOverlay::advance()
+{
+    qint64 now = clock.elapsed();
+    qint64 elapsed = now - lastFrame;
+    lastFrame = now;
+
+    // Move everything on; comments that have left the screen go back to the pool
+    for (size_t i = 0; i < live.size();) {
+        Bullet &bullet = bullets[live[i]];
+        bullet.x -= bullet.speed * elapsed;
+        if (bullet.x + bullet.width < 0) {
+            release(live[i]);
+            live[i] = live.back();
+            live.pop_back();
+        } else {
+            ++i;
+        }
+    }
+
+    while (!waiting.isEmpty() && tryLaunch(waiting.head())) {
+        waiting.dequeue();
+    }
+    for (int i = 0; i < qMin(waiting.size(), renderAhead); ++i) {
+        renderer.request(waiting.at(i));  // Also brings back images the cache has dropped meanwhile
+    }
+
+    if (live.empty() && waiting.isEmpty()) {
+        frameTimer.stop();  // Nothing to move; no frames until the next comment
+    }
+    update();
+}
+
+bool DanmakuOverlay::tryLaunch(const QString &text)
+{
+    QImage image = renderer.image(text);
+    if (image.isNull()) {
+        renderer.request(text);
+        return false;
+    }
+
+    // Longer comments cross faster, so every comment is on screen for the same time
+    int boxWidth = int(image.width() / image.devicePixelRatioF());
+    qreal speed = qreal(width() + boxWidth) / flightMs;
+
+    for (int lane = 0; lane < int(laneTails.size()); ++lane) {
+        if (!laneHasRoom(lane, speed)) {
+            continue;
+        }
+        int index = allocate();
+        Bullet &bullet = bullets[index];
+        bullet.image = image;
+        bullet.width = boxWidth;
+        bullet.x = width();
+        bullet.speed = speed;
+        bullet.lane = lane;
+        bullet.top = laneTop(lane);
+        laneTails[lane] = index;
+        live.push_back(index);
+        return true;
+    }
+    return false;
+}
+
+bool DanmakuOverlay::laneHasRoom(int lane, qreal speed) const
+{
+    int tail = laneTails[lane];
+    if (tail < 0) {
+        return true;
+    }
+
+    // The comment ahead has to be fully on screen, with a gap behind it
+    const Bullet &ahead = bullets[tail];
+    qreal aheadEnd = ahead.x + ahead.width;
+    if (aheadEnd + laneGap > width()) {
+        return false;
+    }
+    if (speed <= ahead.speed) {
+        return true;
+    }
+
+    // A faster comment must not reach the left edge before the one ahead has left it
+    qreal aheadLeaves = aheadEnd / ahead.speed;
+    return width() - speed * aheadLeaves >= 0;
+}
+
+int DanmakuOverlay::laneTop(int lane) const
+{
+    int laneHeight = renderer.boxHeight() + laneSpacing;
+    int perLayer = lanesPerLayer();
+    int layer = lane / perLayer;
+    return lane % perLayer * laneHeight + layer % 2 * laneHeight / 2;  // Every other layer sits half a lane down
+}
+
+int DanmakuOverlay::lanesPerLayer() const
+{
+    int laneHeight = renderer.boxHeight() + laneSpacing;
+    return qMax(1, height() / laneHeight);
+}
+
+int DanmakuOverlay::allocate()
+{
+    if (freeSlots >= 0) {
+        int index = freeSlots;
+        freeSlots = bullets[index].nextFree;
+        return index;
+    }
+    bullets.emplace_back();
+    return int(bullets.size()) - 1;
+}
+
+void DanmakuOverlay::release(int index)
+{
+    Bullet &bullet = bullets[index];
+    if (bullet.lane < int(laneTails.size()) && laneTails[bullet.lane] == index) {
+        laneTails[bullet.lane] = -1;  // The lane is empty behind it
+    }
+    bullet.image = QImage();  // The cache keeps it as long as it is worth keeping
+    bullet.nextFree = freeSlots;
+    freeSlots = index;
+}
+
+void DanmakuOverlay::wake()
+{
+    if (!frameTimer.isActive()) {
+        lastFrame = clock.elapsed();
+        frameTimer.start();
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef DANMAKUOVERLAY_H
+#define DANMAKUOVERLAY_H
+
+#include "commentRenderer.h"
+#include <QElapsedTimer>
+#include <QImage>
+#include <QQueue>
+#include <QString>
+#include <QTimer>
+#include <QWidget>
+#include <vector>
+
+// DanmakuOverlay flies comments across the video from right to left. It is one
+// transparent widget on top of the video that paints every comment in flight in a
+// single pass per frame; each comment is rendered once, off the GUI thread, by a
+// CommentRenderer, so a frame costs one image copy per comment.
+//
+// Comments run in horizontal lanes; a comment only enters a lane once the one ahead
+// of it has moved clear and cannot be caught up with, so comments never overlap
+// while there is room. When every lane is taken, further layers of lanes are opened
+// half a lane down, and only when those are full too do comments wait for a free
+// lane. A comment also waits while its image is rendered. Comments live in a pool of
+// reused slots, so a busy stream allocates nothing per comment.
+//
+// tools/danmakuBench drives the overlay with a synthetic stream and measures it.
+class DanmakuOverlay : public QWidget
+{
+    Q_OBJECT
+
+public:
+    // Constructor: the overlay covers the given video widget and follows its size
+    explicit DanmakuOverlay(QWidget *video);
+
+    // Fly a comment in from the right edge, as soon as a lane has room for it
+    void launch(const QString &text);
+
+    // Remove every comment in flight or waiting
+    void clear();
+
+    // Comments on screen, waiting for a lane, and dropped because too many were waiting
+    int activeCount() const { return int(live.size()); }
+    int waitingCount() const { return waiting.size(); }
+    int droppedCount() const { return dropped; }
+
+protected:
+    // Paints every comment in flight
+    void paintEvent(QPaintEvent *event) override;
+
+    // Follows the size of the video widget
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    // Move every comment on by the time since the last frame, retire the ones gone and launch waiting ones
+    void advance();
+
+private:
+    // One comment in flight, or a free slot of the pool
+    struct Bullet {
+        QImage image;       // Box and text, rendered once
+        int width = 0;      // Width of the box, padding included
+        qreal x = 0;        // Left edge of the box
+        int top = 0;        // Top edge of the box, fixed at launch so a resize does not move it
+        qreal speed = 0;    // Pixels per millisecond
+        int lane = -1;      // Lane the comment runs in
+        int nextFree = -1;  // Next free slot while this one is free
+    };
+
+    // Put a comment into the first lane with room for it; returns false if there is none or it is not rendered yet
+    bool tryLaunch(const QString &text);
+
+    // Whether a comment of the given speed can enter a lane right now
+    bool laneHasRoom(int lane, qreal speed) const;
+
+    // Top edge of a lane
+    int laneTop(int lane) const;
+
+    // Lanes per layer at the current height
+    int lanesPerLayer() const;
+
+    // Take a slot from the pool, growing it if every slot is in use
+    int allocate();
+
+    // Return a slot to the pool
+    void release(int index);
+
+    // Start the frame timer if there is anything to move
+    void wake();
+
+    QWidget *video;                  // Widget the overlay covers
+    CommentRenderer renderer;        // Renders and caches the image of every comment
+    std::vector<Bullet> bullets;     // The pool: slots in flight and free ones
+    std::vector<int> live;           // Slots in flight
+    int freeSlots = -1;              // First free slot, or -1
+    std::vector<int> laneTails;      // Last slot launched into each lane, or -1
+    QQueue<QString> waiting;         // Comments waiting for a lane, oldest first
+    int dropped = 0;                 // Comments dropped because the queue was full
+    QTimer frameTimer;               // Drives the frames while anything is in flight
+    QElapsedTimer clock;             // Time base of the frames
+    qint64 lastFrame = 0;            // Clock time of the previous frame
+};
+
+#endif // DANMAKUOVERLAY_H
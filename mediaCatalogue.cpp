@@ -0,0 +1,144 @@
+#include "mediaCatalogue.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+
+const quint32 fileMagic = 0x544f4d43;  // "TOMC"
+const quint32 fileVersion = 2;         // Layout version of the records; version 1 had no play counts
+
+}
+
+void MediaCatalogue::load()
+{
+    records.clear();
+    paths.clear();
+
+    QFile file(catalogueFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;  // First launch
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_11);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    in >> magic >> version >> count;
+    if (magic != fileMagic || version < 1 || version > fileVersion) {
+        return;  // From another version; it is rebuilt as videos are indexed again
+    }
+
+    records.reserve(int(count));
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Record record;
+        MediaLibrary::MediaInfo &info = record.info;
+        in >> path >> record.fileSize >> record.modified
+           >> info.duration >> info.resolution >> info.videoCodec >> info.audioCodec
+           >> info.bitRate >> info.created;
+        if (version >= 2) {
+            in >> info.plays;
+        }
+        if (in.status() == QDataStream::Ok) {
+            records.insert(path, record);
+            paths.insert(qMakePair(record.fileSize, record.modified), path);
+        }
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qDebug() << "Warning: media catalogue " << file.fileName() << " is truncated, keeping the first " << records.size() << " entries.";
+    }
+}
+
+bool MediaCatalogue::save() const
+{
+    QDir().mkpath(QFileInfo(catalogueFilePath()).absolutePath());
+
+    // QSaveFile only replaces the old file once the new one is complete
+    QSaveFile file(catalogueFilePath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_11);
+    out << fileMagic << fileVersion << quint32(records.size());
+    for (auto record = records.constBegin(); record != records.constEnd(); ++record) {
+        const MediaLibrary::MediaInfo &info = record->info;
+        out << record.key() << record->fileSize << record->modified
+            << info.duration << info.resolution << info.videoCodec << info.audioCodec
+            << info.bitRate << info.created << info.plays;
+    }
+    return file.commit();
+}
+
+bool MediaCatalogue::lookup(const QString &path, qint64 fileSize, qint64 modified, MediaLibrary::MediaInfo *info) const
+{
+    auto record = records.constFind(path);
+    if (record == records.constEnd() || record->fileSize != fileSize || record->modified != modified) {
+        return false;
+    }
+    *info = record->info;
+    return true;
+}
+
+void MediaCatalogue::insert(const QString &path, qint64 fileSize, qint64 modified, const MediaLibrary::MediaInfo &info)
+{
+    auto old = records.constFind(path);
+    if (old != records.constEnd() && paths.value(qMakePair(old->fileSize, old->modified)) == path) {
+        paths.remove(qMakePair(old->fileSize, old->modified));
+    }
+    records.insert(path, Record{fileSize, modified, info});
+    paths.insert(qMakePair(fileSize, modified), path);
+}
+
+int MediaCatalogue::playCount(const QString &path) const
+{
+    auto record = records.constFind(path);
+    return record == records.constEnd() ? 0 : record->info.plays;
+}
+
+int MediaCatalogue::addPlay(const QString &path, int plays)
+{
+    // A video played before it was probed gets an entry no lookup matches, until the probe fills it in
+    Record &record = records[path];
+    record.info.plays += plays;
+    return record.info.plays;
+}
+
+bool MediaCatalogue::adopt(const QString &path, qint64 fileSize, qint64 modified)
+{
+    QString oldPath = paths.value(qMakePair(fileSize, modified));
+    if (oldPath.isEmpty() || oldPath == path || QFileInfo::exists(oldPath)) {
+        return false;  // Never seen, or a copy of a file that is still there
+    }
+
+    Record record = records.take(oldPath);
+    record.info.plays += playCount(path);  // In case it was played under its new name before it was indexed
+    records.insert(path, record);
+    paths.insert(qMakePair(fileSize, modified), path);
+    return true;
+}
+
+void MediaCatalogue::remove(const QString &path)
+{
+    auto record = records.constFind(path);
+    if (record == records.constEnd()) {
+        return;
+    }
+    if (paths.value(qMakePair(record->fileSize, record->modified)) == path) {
+        paths.remove(qMakePair(record->fileSize, record->modified));
+    }
+    records.remove(path);
+}
+
+QString MediaCatalogue::catalogueFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/catalogue.dat";
+}
@@ -0,0 +1,58 @@
+#ifndef MEDIACATALOGUE_H
+#define MEDIACATALOGUE_H
+
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include "mediaLibrary.h"
+
+// MediaCatalogue remembers the technical details of every video that has ever been
+// indexed, and how often it has been played, in one file in the application's data
+// folder. Entries are keyed by the video's path and only match while its size and
+// modification time agree, so a later launch can show full details without opening
+// a single video. The play count outlives a stale entry. Entries are also found by
+// size and modification time, so a video that was renamed or moved keeps its entry.
+class MediaCatalogue
+{
+public:
+    // Read the catalogue written by earlier runs; a missing or unreadable file leaves it empty
+    void load();
+
+    // Write the whole catalogue, replacing the file atomically; returns false on failure
+    bool save() const;
+
+    // Look up the details of a video; returns false on a miss
+    bool lookup(const QString &path, qint64 fileSize, qint64 modified, MediaLibrary::MediaInfo *info) const;
+
+    // Remember the details of a video, replacing what was known about it before
+    void insert(const QString &path, qint64 fileSize, qint64 modified, const MediaLibrary::MediaInfo &info);
+
+    // Times the video at the given path has been played
+    int playCount(const QString &path) const;
+
+    // Count more plays of the video at the given path; returns the new count
+    int addPlay(const QString &path, int plays = 1);
+
+    // Move the entry of a video that has since been renamed to the given path: one with the same size and
+    // modification time whose own file is gone. Returns false if there is none.
+    bool adopt(const QString &path, qint64 fileSize, qint64 modified);
+
+    // Forget a video that no longer exists
+    void remove(const QString &path);
+
+    // Location of the catalogue file on disk
+    static QString catalogueFilePath();
+
+private:
+    // What is known about one video file
+    struct Record {
+        qint64 fileSize = -1;         // Size of the video file when it was probed, or -1 before it was
+        qint64 modified = -1;         // Modification time of the video file (ms since epoch)
+        MediaLibrary::MediaInfo info; // What the probe found
+    };
+
+    QHash<QString, Record> records;  // Every indexed video, by absolute path
+    QHash<QPair<qint64, qint64>, QString> paths;  // Path of an indexed video by its size and modification time
+};
+
+#endif // MEDIACATALOGUE_H
@@ -0,0 +1,323 @@
+#include "mediaIndexer.h"
+#include "mediaProbe.h"
+#include <QDate>
+#include <QDateTime>
+#include <QMediaMetaData>
+#include <QMediaPlayer>
+#include <QRunnable>
+#include <QThread>
+#include <QUrl>
+
+namespace {
+
+const int maxBackendProbes = 2;      // Media players opened at once for containers the probe does not read
+const int backendTimeoutMs = 5000;   // Give up on a media player probe after this long
+const int saveDelayMs = 2000;        // Catalogue writes are coalesced over this long while indexing
+
+}
+
+// Probes one video; runs on one of the indexer's worker threads
+class ProbeTask : public QRunnable
+{
+public:
+    ProbeTask(MediaIndexer *indexer, const MediaIndexer::Request &request)
+        : indexer(indexer), request(request) {}
+
+    void run() override
+    {
+        MediaLibrary::MediaInfo info;
+        bool understood = MediaProbe::probe(request.path, &info);
+
+        // Deliver the result through the indexer's event queue on the GUI thread
+        MediaIndexer *target = indexer;
+        MediaIndexer::Request done = request;
+        QMetaObject::invokeMethod(indexer, [target, done, understood, info]() {
+            target->probed(done, understood, info);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    MediaIndexer *indexer;            // Indexer that receives the details
+    MediaIndexer::Request request;    // Video to probe
+};
+
+// Reads the catalogue written by earlier runs; runs on one of the indexer's worker threads
+class CatalogueLoadTask : public QRunnable
+{
+public:
+    explicit CatalogueLoadTask(MediaIndexer *indexer)
+        : indexer(indexer) {}
+
+    void run() override
+    {
+        MediaCatalogue catalogue;
+        catalogue.load();
+
+        MediaIndexer *target = indexer;
+        QMetaObject::invokeMethod(indexer, [target, catalogue]() {
+            target->catalogueLoaded(catalogue);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    MediaIndexer *indexer;  // Indexer that receives the catalogue
+};
+
+// Writes a snapshot of the catalogue; runs on one of the indexer's worker threads
+class CatalogueSaveTask : public QRunnable
+{
+public:
+    CatalogueSaveTask(MediaIndexer *indexer, const MediaCatalogue &catalogue)
+        : indexer(indexer), catalogue(catalogue) {}
+
+    void run() override
+    {
+        catalogue.save();
+
+        MediaIndexer *target = indexer;
+        QMetaObject::invokeMethod(indexer, [target]() {
+            target->saving = false;
+            if (target->saveAgain) {
+                target->saveAgain = false;
+                target->saveCatalogue();
+            }
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    MediaIndexer *indexer;      // Indexer to tell when the write is done
+    MediaCatalogue catalogue;   // Snapshot to write; shares its data with the live catalogue until that changes
+};
+
+MediaIndexer::MediaIndexer(QObject *parent)
+    : QObject(parent)
+{
+    // Probing is mostly waiting for the disk, so a few workers are enough to keep it busy
+    pool.setMaxThreadCount(qBound(2, QThread::idealThreadCount(), 4));
+
+    // A large catalogue takes a moment to read, which the window should not wait for
+    pool.start(new CatalogueLoadTask(this));
+
+    saveTimer.setSingleShot(true);
+    saveTimer.setInterval(saveDelayMs);
+    connect(&saveTimer, &QTimer::timeout, this, &MediaIndexer::saveCatalogue);
+}
+
+MediaIndexer::~MediaIndexer()
+{
+    queue.clear();
+    pool.waitForDone();  // Running probes and writes still reference this indexer
+
+    // Anything found since the last write is kept for the next launch
+    if (saveTimer.isActive() || saveAgain) {
+        catalogue.save();
+    }
+}
+
+void MediaIndexer::index(const QString &path, qint64 fileSize, qint64 modified)
+{
+    if (pending.contains(path)) {
+        return;  // Already on its way
+    }
+
+    // A catalogue hit is only a hash lookup, so it is delivered right away
+    MediaLibrary::MediaInfo info;
+    if (loaded && lookup(path, fileSize, modified, &info)) {
+        emit infoReady(path, info);
+        return;
+    }
+
+    pending.insert(path);
+    queue.append(Request{path, fileSize, modified});
+    dispatch();
+}
+
+void MediaIndexer::forget(const QString &path)
+{
+    if (!loaded) {
+        earlyPlays.remove(path);
+        earlyForgotten.insert(path);
+        return;
+    }
+    catalogue.remove(path);
+    saveTimer.start();
+}
+
+int MediaIndexer::notePlayed(const QString &path)
+{
+    if (!loaded) {
+        // Only this session's plays for now; the video's details, due once the catalogue is read, bring the total
+        earlyForgotten.remove(path);
+        return ++earlyPlays[path];
+    }
+    int plays = catalogue.addPlay(path);
+    saveTimer.start();
+    return plays;
+}
+
+void MediaIndexer::cancelAll()
+{
+    for (const Request &request : queue) {
+        pending.remove(request.path);
+    }
+    for (const Request &request : backendQueue) {
+        pending.remove(request.path);
+    }
+    queue.clear();
+    backendQueue.clear();
+}
+
+void MediaIndexer::catalogueLoaded(const MediaCatalogue &found)
+{
+    catalogue = found;
+    loaded = true;
+
+    // Videos asked for meanwhile are answered first, so a rename is matched before the old name is forgotten
+    for (auto play = earlyPlays.constBegin(); play != earlyPlays.constEnd(); ++play) {
+        catalogue.addPlay(play.key(), play.value());
+    }
+    QList<Request> waiting;
+    waiting.swap(queue);
+    for (const Request &request : waiting) {
+        MediaLibrary::MediaInfo info;
+        if (lookup(request.path, request.fileSize, request.modified, &info)) {
+            pending.remove(request.path);
+            emit infoReady(request.path, info);
+        } else {
+            queue.append(request);
+        }
+    }
+    for (const QString &path : earlyForgotten) {
+        catalogue.remove(path);
+    }
+    if (!earlyPlays.isEmpty() || !earlyForgotten.isEmpty()) {
+        saveTimer.start();
+    }
+    earlyPlays.clear();
+    earlyForgotten.clear();
+
+    dispatch();
+}
+
+bool MediaIndexer::lookup(const QString &path, qint64 fileSize, qint64 modified, MediaLibrary::MediaInfo *info)
+{
+    if (catalogue.lookup(path, fileSize, modified, info)) {
+        return true;
+    }
+
+    // Renamed or moved since it was indexed: the entry follows the file
+    if (catalogue.adopt(path, fileSize, modified)) {
+        saveTimer.start();
+        return catalogue.lookup(path, fileSize, modified, info);
+    }
+    return false;
+}
+
+void MediaIndexer::dispatch()
+{
+    if (!loaded) {
+        return;  // Every video might still turn out to be in the catalogue
+    }
+    while (running < pool.maxThreadCount() && !queue.isEmpty()) {
+        running++;
+        pool.start(new ProbeTask(this, queue.takeFirst()));
+    }
+}
+
+void MediaIndexer::probed(const Request &request, bool understood, const MediaLibrary::MediaInfo &info)
+{
+    running--;
+    if (understood) {
+        deliver(request, info);
+    } else {
+        backendQueue.append(request);  // Not an ISO media file; let the media backend have a look
+        startBackendProbes();
+    }
+    dispatch();  // A worker has become free
+}
+
+void MediaIndexer::startBackendProbes()
+{
+    while (backendProbes.size() < maxBackendProbes && !backendQueue.isEmpty()) {
+        Request request = backendQueue.takeFirst();
+
+        // A muted player without a video output only loads the file, it never decodes a frame
+        QMediaPlayer *probe = new QMediaPlayer(this);
+        probe->setMuted(true);
+        backendProbes.insert(probe, request);
+
+        connect(probe, &QMediaPlayer::mediaStatusChanged, this, [this, probe](QMediaPlayer::MediaStatus status) {
+            if (status == QMediaPlayer::LoadedMedia || status == QMediaPlayer::BufferedMedia
+                    || status == QMediaPlayer::InvalidMedia) {
+                finishBackendProbe(probe);
+            }
+        });
+        QTimer::singleShot(backendTimeoutMs, probe, [this, probe]() {
+            finishBackendProbe(probe);  // Keep whatever the backend found so far
+        });
+
+        probe->setMedia(QUrl::fromLocalFile(request.path));
+    }
+}
+
+void MediaIndexer::finishBackendProbe(QMediaPlayer *probe)
+{
+    auto found = backendProbes.find(probe);
+    if (found == backendProbes.end()) {
+        return;  // Already finished by an earlier status change
+    }
+    Request request = found.value();
+    backendProbes.erase(found);
+
+    MediaLibrary::MediaInfo info;
+    if (probe->duration() > 0) {
+        info.duration = probe->duration();
+    }
+    info.resolution = probe->metaData(QMediaMetaData::Resolution).toSize();
+    info.videoCodec = probe->metaData(QMediaMetaData::VideoCodec).toString();
+    info.audioCodec = probe->metaData(QMediaMetaData::AudioCodec).toString();
+    int bitRate = probe->metaData(QMediaMetaData::VideoBitRate).toInt() + probe->metaData(QMediaMetaData::AudioBitRate).toInt();
+    if (bitRate > 0) {
+        info.bitRate = bitRate;
+    } else if (info.duration > 0) {
+        info.bitRate = request.fileSize * 8 * 1000 / info.duration;
+    }
+    QDate date = probe->metaData(QMediaMetaData::Date).toDate();
+    if (date.isValid()) {
+        info.created = date.startOfDay().toMSecsSinceEpoch();
+    }
+
+    probe->disconnect(this);
+    probe->deleteLater();
+
+    // Even an empty result is recorded, so the file is not opened again on every launch
+    deliver(request, info);
+    startBackendProbes();
+}
+
+void MediaIndexer::deliver(const Request &request, const MediaLibrary::MediaInfo &info)
+{
+    pending.remove(request.path);
+
+    // A probe only finds what is in the file; the play count is kept from the old entry
+    MediaLibrary::MediaInfo found = info;
+    found.plays = catalogue.playCount(request.path);
+    catalogue.insert(request.path, request.fileSize, request.modified, found);
+    saveTimer.start();
+    emit infoReady(request.path, found);
+}
+
+void MediaIndexer::saveCatalogue()
+{
+    if (!loaded) {
+        return;  // Writing now would replace the file with what little is known so far
+    }
+    if (saving) {
+        saveAgain = true;  // Picked up when the running write is done
+        return;
+    }
+
+    // Writes jump ahead of queued probes, but there is never more than one at a time
+    saving = true;
+    pool.start(new CatalogueSaveTask(this, catalogue), 1);
+}
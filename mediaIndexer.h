@@ -0,0 +1,101 @@
+#ifndef MEDIAINDEXER_H
+#define MEDIAINDEXER_H
+
+#include "mediaCatalogue.h"
+#include "mediaLibrary.h"
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QThreadPool>
+#include <QTimer>
+
+class QMediaPlayer;
+
+// MediaIndexer finds the duration, frame size, codecs, bit rate and creation time of
+// every video. Videos already in the catalogue are answered straight away; the rest
+// are probed in parallel on a worker pool, which reads ISO media files (.mp4, .mov)
+// directly. Containers the probe does not understand are handed to a couple of muted
+// media players on the GUI thread instead. Everything found is written back to the
+// catalogue, so the next launch starts with full details. The catalogue is read on the
+// worker pool too; videos asked for before it is ready wait for it.
+class MediaIndexer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Constructor: creates the probing pool and starts reading the catalogue on it
+    explicit MediaIndexer(QObject *parent = nullptr);
+
+    // Destructor: drops queued probes, waits for running ones and saves the catalogue
+    ~MediaIndexer();
+
+    // Deliver the details of the video at the given path, from the catalogue or by probing it.
+    // The size and modification time come from the scan and decide whether the catalogue entry is current.
+    void index(const QString &path, qint64 fileSize, qint64 modified);
+
+    // Forget a video that has left the library
+    void forget(const QString &path);
+
+    // Count one more play of the video at the given path; returns the new count
+    int notePlayed(const QString &path);
+
+    // Drop every probe that has not started yet
+    void cancelAll();
+
+signals:
+    // Emitted on the GUI thread with the details of a video
+    void infoReady(const QString &path, const MediaLibrary::MediaInfo &info);
+
+private:
+    friend class ProbeTask;
+    friend class CatalogueLoadTask;
+    friend class CatalogueSaveTask;
+
+    // A video waiting to be probed
+    struct Request {
+        QString path;
+        qint64 fileSize;
+        qint64 modified;
+    };
+
+    // Called on the GUI thread with the catalogue as read from disk; answers the videos that waited for it
+    void catalogueLoaded(const MediaCatalogue &found);
+
+    // Look a video up in the catalogue, also under the name it had before a rename; returns false on a miss
+    bool lookup(const QString &path, qint64 fileSize, qint64 modified, MediaLibrary::MediaInfo *info);
+
+    // Hand queued probes to idle workers
+    void dispatch();
+
+    // Called on the GUI thread when a worker has probed a video; falls back to the media backend if it could not
+    void probed(const Request &request, bool understood, const MediaLibrary::MediaInfo &info);
+
+    // Start media player probes for queued videos, up to the limit
+    void startBackendProbes();
+
+    // Collect what a media player probe found and start the next one
+    void finishBackendProbe(QMediaPlayer *probe);
+
+    // Record the details of a video in the catalogue and hand them out
+    void deliver(const Request &request, const MediaLibrary::MediaInfo &info);
+
+    // Write the catalogue on the worker pool, unless a write is already running
+    void saveCatalogue();
+
+    MediaCatalogue catalogue;                  // Details of every video indexed so far
+    bool loaded = false;                       // Whether the catalogue has been read from disk
+    QHash<QString, int> earlyPlays;            // Plays counted before the catalogue was read, by path
+    QSet<QString> earlyForgotten;              // Videos forgotten before the catalogue was read
+    QThreadPool pool;                          // Worker threads used for probing
+    QList<Request> queue;                      // Videos not handed to a worker yet, in order
+    int running = 0;                           // Probes handed to the pool and not finished yet
+    QSet<QString> pending;                     // Paths queued or being probed
+    QList<Request> backendQueue;               // Videos waiting for a media player probe
+    QHash<QMediaPlayer *, Request> backendProbes; // Media player probes in progress
+    QTimer saveTimer;                          // Coalesces catalogue writes while indexing
+    bool saving = false;                       // Whether a catalogue write is running
+    bool saveAgain = false;                    // Whether the catalogue changed during that write
+};
+
+#endif // MEDIAINDEXER_H
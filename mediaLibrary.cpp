@@ -0,0 +1,398 @@
+#include "mediaLibrary.h"
+#include <QDir>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+const int compactThreshold = 64 * 1024;  // Dead characters tolerated in the name pool before it is rewritten
+
+// Sort keys spell every character as two bytes; a digit run starts with this pair instead,
+// which is below any character a file name can hold, so numbers sort before text
+const char numberMarker[2] = {0, 1};
+
+// Rearrange the values so that the one at index i comes from index permutation[i]
+template <typename T>
+void permute(std::vector<T> &values, const std::vector<int> &permutation)
+{
+    std::vector<T> result;
+    result.reserve(permutation.size());
+    for (int from : permutation) {
+        result.push_back(std::move(values[from]));
+    }
+    values.swap(result);
+}
+
+}
+
+void MediaLibrary::reset(const QString &folderPath)
+{
+    folder = QDir(folderPath).absolutePath();
+    names.clear();
+    deadNameChars = 0;
+    keys.clear();
+    idIndex.clear();
+    thumbnailNames.clear();
+    ids.clear();
+    nameSpans.clear();
+    keyPrefixes.clear();
+    keySpans.clear();
+    durations.clear();
+    thumbnailSizes.clear();
+    thumbnailStamps.clear();
+    views.clear();
+    fileSizes.clear();
+    fileStamps.clear();
+    resolutions.clear();
+    videoCodecs.clear();
+    audioCodecs.clear();
+    bitRates.clear();
+    createdTimes.clear();
+}
+
+int MediaLibrary::indexOf(const QString &fileName) const
+{
+    int index = insertionIndex(fileName);
+    if (index >= count() || nameRef(index) != fileName) {
+        return -1;
+    }
+    return index;
+}
+
+int MediaLibrary::insertionIndex(const QString &fileName) const
+{
+    // Binary search straight over the pool, without building a string per probe
+    int low = 0;
+    int high = count();
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (lessByName(nameRef(middle), QStringRef(&fileName))) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+std::vector<int> MediaLibrary::insertAll(const std::vector<ScannedVideo> &videos)
+{
+    int before = count();
+    for (const ScannedVideo &video : videos) {
+        NameSpan span{quint32(names.size()), quint32(video.fileName.size())};
+        names += video.fileName;
+
+        // The sort key is worked out once here; sorting only compares bytes from then on
+        QByteArray key = naturalKey(video.fileName);
+        NameSpan keySpan{quint32(keys.size()), quint32(key.size())};
+        quint64 prefix = 0;
+        for (int i = 0; i < 8; ++i) {
+            prefix = (prefix << 8) | (i < key.size() ? quint8(key[i]) : 0);
+        }
+        keys += key;
+
+        if (!video.thumbnailName.isEmpty()) {
+            thumbnailNames.insert(quint32(idIndex.size()), video.thumbnailName);
+        }
+        ids.push_back(quint32(idIndex.size()));
+        idIndex.push_back(-1);
+        nameSpans.push_back(span);
+        keyPrefixes.push_back(prefix);
+        keySpans.push_back(keySpan);
+        durations.push_back(-1);
+        thumbnailSizes.push_back(video.thumbnailSize);
+        thumbnailStamps.push_back(video.thumbnailModified);
+        views.push_back(0);  // Until the catalogue says otherwise
+        fileSizes.push_back(video.fileSize);
+        fileStamps.push_back(video.fileModified);
+        resolutions.push_back(QSize());
+        videoCodecs.push_back(0);
+        audioCodecs.push_back(0);
+        bitRates.push_back(-1);
+        createdTimes.push_back(-1);
+    }
+
+    // The appended videos are sorted among themselves, then merged with the sorted ones before them
+    auto byName = [this](int a, int b) { return lessByName(nameRef(a), nameRef(b)); };
+    std::vector<int> existing(before);
+    std::vector<int> added(count() - before);
+    for (int index = 0; index < count(); ++index) {
+        (index < before ? existing[index] : added[index - before]) = index;
+    }
+    std::sort(added.begin(), added.end(), byName);
+    std::vector<int> permutation;
+    permutation.reserve(count());
+    std::merge(existing.begin(), existing.end(), added.begin(), added.end(), std::back_inserter(permutation), byName);
+
+    permute(ids, permutation);
+    permute(nameSpans, permutation);
+    permute(keyPrefixes, permutation);
+    permute(keySpans, permutation);
+    permute(durations, permutation);
+    permute(thumbnailSizes, permutation);
+    permute(thumbnailStamps, permutation);
+    permute(views, permutation);
+    permute(fileSizes, permutation);
+    permute(fileStamps, permutation);
+    permute(resolutions, permutation);
+    permute(videoCodecs, permutation);
+    permute(audioCodecs, permutation);
+    permute(bitRates, permutation);
+    permute(createdTimes, permutation);
+    reindexIds(0);
+
+    std::vector<int> moved(before);
+    for (int index = 0; index < count(); ++index) {
+        if (permutation[index] < before) {
+            moved[permutation[index]] = index;
+        }
+    }
+    return moved;
+}
+
+void MediaLibrary::remove(int index)
+{
+    deadNameChars += nameSpans[index].length;
+    idIndex[ids[index]] = -1;
+    thumbnailNames.remove(ids[index]);
+
+    ids.erase(ids.begin() + index);
+    nameSpans.erase(nameSpans.begin() + index);
+    keyPrefixes.erase(keyPrefixes.begin() + index);
+    keySpans.erase(keySpans.begin() + index);
+    durations.erase(durations.begin() + index);
+    thumbnailSizes.erase(thumbnailSizes.begin() + index);
+    thumbnailStamps.erase(thumbnailStamps.begin() + index);
+    views.erase(views.begin() + index);
+    fileSizes.erase(fileSizes.begin() + index);
+    fileStamps.erase(fileStamps.begin() + index);
+    resolutions.erase(resolutions.begin() + index);
+    videoCodecs.erase(videoCodecs.begin() + index);
+    audioCodecs.erase(audioCodecs.begin() + index);
+    bitRates.erase(bitRates.begin() + index);
+    createdTimes.erase(createdTimes.begin() + index);
+    reindexIds(index);
+
+    // Removed names only waste pool space, so rewrite the pool once they make up most of it
+    if (deadNameChars > compactThreshold && deadNameChars > names.size() / 2) {
+        compactNames();
+    }
+}
+
+void MediaLibrary::setThumbnail(int index, qint64 fileSize, qint64 modified, const QString &thumbnailName)
+{
+    thumbnailSizes[index] = fileSize;
+    thumbnailStamps[index] = modified;
+    if (thumbnailName.isEmpty()) {
+        thumbnailNames.remove(ids[index]);
+    } else {
+        thumbnailNames.insert(ids[index], thumbnailName);
+    }
+}
+
+void MediaLibrary::setFileStamp(int index, qint64 fileSize, qint64 modified)
+{
+    fileSizes[index] = fileSize;
+    fileStamps[index] = modified;
+}
+
+void MediaLibrary::setInfo(int index, const MediaInfo &info)
+{
+    durations[index] = info.duration;
+    resolutions[index] = info.resolution;
+    videoCodecs[index] = internCodec(info.videoCodec);
+    audioCodecs[index] = internCodec(info.audioCodec);
+    bitRates[index] = info.bitRate;
+    createdTimes[index] = info.created;
+    views[index] = info.plays;
+}
+
+MediaLibrary::MediaInfo MediaLibrary::info(int index) const
+{
+    MediaInfo info;
+    info.duration = durations[index];
+    info.resolution = resolutions[index];
+    info.videoCodec = videoCodec(index);
+    info.audioCodec = codecNames.at(audioCodecs[index]);
+    info.bitRate = bitRates[index];
+    info.created = createdTimes[index];
+    info.plays = views[index];
+    return info;
+}
+
+bool MediaLibrary::sortsBefore(SortOrder order, int a, int b) const
+{
+    switch (order) {
+    case SortByDuration:
+        if (durations[a] != durations[b]) {
+            // Unknown durations are -1; they go last rather than first
+            return durations[b] < 0 || (durations[a] >= 0 && durations[a] < durations[b]);
+        }
+        break;
+    case SortByDateAdded:
+        if (fileStamps[a] != fileStamps[b]) {
+            return fileStamps[a] > fileStamps[b];
+        }
+        break;
+    case SortByViews:
+        if (views[a] != views[b]) {
+            return views[a] > views[b];
+        }
+        break;
+    default:
+        break;
+    }
+    return lessByKey(a, b);
+}
+
+std::vector<int> MediaLibrary::sortedIndices(SortOrder order) const
+{
+    std::vector<int> sorted(count());
+    for (int index = 0; index < count(); ++index) {
+        sorted[index] = index;
+    }
+    std::sort(sorted.begin(), sorted.end(), [this, order](int a, int b) { return sortsBefore(order, a, b); });
+    return sorted;
+}
+
+QStringRef MediaLibrary::nameRef(int index) const
+{
+    const NameSpan &span = nameSpans[index];
+    return QStringRef(&names, int(span.offset), int(span.length));
+}
+
+bool MediaLibrary::lessByName(const QStringRef &a, const QStringRef &b)
+{
+    // Same order QDir::entryList used to give the playlist: by name, ignoring case
+    int order = a.compare(b, Qt::CaseInsensitive);
+    return order != 0 ? order < 0 : a.compare(b, Qt::CaseSensitive) < 0;
+}
+
+QByteArray MediaLibrary::naturalKey(const QString &fileName)
+{
+    // Case-folded characters as big-endian pairs, and every run of digits as the marker,
+    // its length without leading zeros, then the digits: a longer number is a larger one
+    QString folded = fileName.toCaseFolded();
+    QByteArray key;
+    key.reserve(folded.size() * 2 + 8);
+    for (int i = 0; i < folded.size();) {
+        ushort unit = folded[i].unicode();
+        if (unit < '0' || unit > '9') {
+            key.append(char(unit >> 8));
+            key.append(char(unit & 0xff));
+            ++i;
+            continue;
+        }
+
+        int end = i;
+        while (end < folded.size() && folded[end] >= QLatin1Char('0') && folded[end] <= QLatin1Char('9')) {
+            ++end;
+        }
+        while (i < end - 1 && folded[i] == QLatin1Char('0')) {
+            ++i;  // "007" sorts as 7; the library order breaks the tie with "7"
+        }
+        int digits = qMin(end - i, 0xffff);
+        key.append(numberMarker, 2);
+        key.append(char(digits >> 8));
+        key.append(char(digits & 0xff));
+        for (int digit = i; digit < i + digits; ++digit) {
+            key.append(char(folded[digit].unicode()));
+        }
+        i = end;
+    }
+    return key;
+}
+
+bool MediaLibrary::lessByKey(int a, int b) const
+{
+    if (keyPrefixes[a] != keyPrefixes[b]) {
+        return keyPrefixes[a] < keyPrefixes[b];
+    }
+
+    const NameSpan &first = keySpans[a];
+    const NameSpan &second = keySpans[b];
+    int order = std::memcmp(keys.constData() + first.offset, keys.constData() + second.offset,
+                            qMin(first.length, second.length));
+    if (order != 0) {
+        return order < 0;
+    }
+    if (first.length != second.length) {
+        return first.length < second.length;
+    }
+    return a < b;  // Same natural name, e.g. "a7" and "a007": keep library order
+}
+
+void MediaLibrary::compactNames()
+{
+    QString pool;
+    pool.reserve(names.size() - deadNameChars);
+    for (NameSpan &span : nameSpans) {
+        quint32 offset = quint32(pool.size());
+        pool.append(names.constData() + span.offset, int(span.length));
+        span.offset = offset;
+    }
+    names = pool;
+    deadNameChars = 0;
+
+    QByteArray keyPool;
+    keyPool.reserve(keys.size());
+    for (NameSpan &span : keySpans) {
+        quint32 offset = quint32(keyPool.size());
+        keyPool.append(keys.constData() + span.offset, int(span.length));
+        span.offset = offset;
+    }
+    keys = keyPool;
+}
+
+void MediaLibrary::reindexIds(int from)
+{
+    for (int index = from; index < count(); ++index) {
+        idIndex[ids[index]] = index;
+    }
+}
+
+quint16 MediaLibrary::internCodec(const QString &name)
+{
+    // A library only ever holds a handful of distinct codecs, so a linear search is enough
+    int id = codecNames.indexOf(name);
+    if (id < 0) {
+        id = codecNames.size();
+        codecNames.append(name);
+    }
+    return quint16(id);
+}
+
+QString MediaLibrary::filePath(int index) const
+{
+    return folder + QLatin1Char('/') + fileName(index);
+}
+
+QUrl MediaLibrary::url(int index) const
+{
+    return QUrl::fromLocalFile(filePath(index));
+}
+
+QString MediaLibrary::thumbnailPath(int index) const
+{
+    auto name = thumbnailNames.constFind(ids[index]);
+    return folder + QLatin1Char('/') + (name != thumbnailNames.constEnd() ? *name : thumbnailNameFor(fileName(index)));
+}
+
+bool MediaLibrary::isVideoFile(const QString &fileName)
+{
+    static const QStringList extensions = {"mp4", "avi", "mkv", "mov", "wmv"};  // Add more formats as needed
+    int dot = fileName.lastIndexOf(QLatin1Char('.'));
+    return dot > 0 && extensions.contains(fileName.mid(dot + 1).toLower());
+}
+
+QString MediaLibrary::thumbnailNameFor(const QString &fileName)
+{
+    // Replace the video file extension with .png
+    return fileName.left(fileName.lastIndexOf(QLatin1Char('.'))) + ".png";
+}
+
+QString MediaLibrary::thumbnailKeyFor(const QString &fileName)
+{
+    return fileName.left(fileName.lastIndexOf(QLatin1Char('.'))).toLower();
+}
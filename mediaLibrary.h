@@ -0,0 +1,212 @@
+#ifndef MEDIALIBRARY_H
+#define MEDIALIBRARY_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <QStringRef>
+#include <QUrl>
+#include <vector>
+
+// MediaLibrary is the single list of videos the player knows about. It is filled
+// from one pass over the folder (see MediaScanner) and kept in case-insensitive name order;
+// the playlist and the title display share its indices, and the list maps its rows onto them.
+// Every field is kept in its own contiguous array and all file names share one string
+// pool, so a video costs a few dozen bytes and no allocation of its own. Each name also
+// gets a natural-order sort key when it is added, so re-sorting never compares QStrings.
+class MediaLibrary
+{
+public:
+    // One video found by a folder walk, together with its own and its thumbnail's size and modification time
+    struct ScannedVideo {
+        QString fileName;          // Name of the video file inside the folder
+        qint64 fileSize;           // Size of the video file
+        qint64 fileModified;       // Modification time of the video file (ms since epoch)
+        qint64 thumbnailSize;      // Size of the .png thumbnail, or -1 when there is none
+        qint64 thumbnailModified;  // Modification time of the thumbnail (ms since epoch)
+        QString thumbnailName;     // Name of the thumbnail when it is not thumbnailNameFor() the video, e.g. "clip.PNG"
+    };
+
+    // Orders the list can be sorted in; ties fall back to natural name order
+    enum SortOrder {
+        SortByName,       // Natural file name order: "clip 2" before "clip 10"
+        SortByDuration,   // Shortest first; unknown durations last
+        SortByDateAdded,  // Newest file first
+        SortByViews,      // Most watched first
+        SortOrderCount
+    };
+
+    // Technical details of one video, as found by MediaIndexer
+    struct MediaInfo {
+        qint64 duration = -1;  // Duration in milliseconds, or -1 when unknown
+        QSize resolution;      // Frame size of the video track; invalid when unknown
+        QString videoCodec;    // Name of the video codec, e.g. "H.264"
+        QString audioCodec;    // Name of the audio codec, e.g. "AAC"
+        qint64 bitRate = -1;   // Overall bit rate in bits per second, or -1 when unknown
+        qint64 created = -1;   // Creation time recorded in the file (ms since epoch), or -1 when unknown
+        int plays = 0;         // Times the video has been played, as counted by the catalogue
+    };
+
+    // Empty the library and point it at a new folder
+    void reset(const QString &folderPath);
+
+    // Index of the video with the given file name, or -1 if it is not in the library
+    int indexOf(const QString &fileName) const;
+
+    // Index a video with the given file name would be inserted at to keep the library sorted
+    int insertionIndex(const QString &fileName) const;
+
+    // Add videos at their sorted positions. The batch is appended, sorted on its own and merged
+    // into the library in one pass, so the cost is per batch rather than per video.
+    // Returns the new index of every video that was already there, by its old index;
+    // indexOf() finds the added ones.
+    std::vector<int> insertAll(const std::vector<ScannedVideo> &videos);
+
+    // Remove the video at the given index
+    void remove(int index);
+
+    // Record a new size, modification time and name (empty for thumbnailNameFor()) for the thumbnail of the video at the given index
+    void setThumbnail(int index, qint64 fileSize, qint64 modified, const QString &thumbnailName);
+
+    // Record a new size and modification time for the video file at the given index
+    void setFileStamp(int index, qint64 fileSize, qint64 modified);
+
+    // Record the technical details of the video at the given index
+    void setInfo(int index, const MediaInfo &info);
+
+    // Number of videos in the library
+    int count() const { return static_cast<int>(nameSpans.size()); }
+
+    // Stable number of the video at the given index; unlike the index it survives inserts and removals
+    quint32 id(int index) const { return ids[index]; }
+
+    // Index of the video with the given id, or -1 once it has been removed
+    int indexOfId(quint32 id) const { return id < idIndex.size() ? idIndex[id] : -1; }
+
+    // Folder the library was scanned from
+    QString folderPath() const { return folder; }
+
+    // File name of the video at the given index (without the folder)
+    QString fileName(int index) const { return nameRef(index).toString(); }
+
+    // Absolute path of the video at the given index
+    QString filePath(int index) const;
+
+    // URL of the video at the given index, as handed to the media player
+    QUrl url(int index) const;
+
+    // Path of the .png thumbnail that belongs to the video at the given index
+    QString thumbnailPath(int index) const;
+
+    // Name of the thumbnail file when it is not thumbnailNameFor() the video, otherwise empty
+    QString thumbnailName(int index) const { return thumbnailNames.value(ids[index]); }
+
+    // Size of the thumbnail file, or -1 when the video has no thumbnail
+    qint64 thumbnailSize(int index) const { return thumbnailSizes[index]; }
+
+    // Modification time of the thumbnail file (ms since epoch)
+    qint64 thumbnailModified(int index) const { return thumbnailStamps[index]; }
+
+    // Size of the video file
+    qint64 fileSize(int index) const { return fileSizes[index]; }
+
+    // Modification time of the video file (ms since epoch)
+    qint64 fileModified(int index) const { return fileStamps[index]; }
+
+    // Duration of the video at the given index in milliseconds, or -1 while it is unknown
+    qint64 duration(int index) const { return durations[index]; }
+
+    // Frame size of the video at the given index; invalid while it is unknown
+    QSize resolution(int index) const { return resolutions[index]; }
+
+    // Name of the video codec of the video at the given index; empty while it is unknown
+    QString videoCodec(int index) const { return codecNames.at(videoCodecs[index]); }
+
+    // Bit rate of the video at the given index in bits per second, or -1 while it is unknown
+    qint64 bitRate(int index) const { return bitRates[index]; }
+
+    // Creation time recorded in the video at the given index (ms since epoch), or -1 while it is unknown
+    qint64 created(int index) const { return createdTimes[index]; }
+
+    // Everything known about the video at the given index
+    MediaInfo info(int index) const;
+
+    // Whether the video at index a comes before the one at index b in the given order
+    bool sortsBefore(SortOrder order, int a, int b) const;
+
+    // Every index of the library, in the given order
+    std::vector<int> sortedIndices(SortOrder order) const;
+
+    // Times the video at the given index has been played
+    int viewCount(int index) const { return views[index]; }
+
+    // Whether the file name has one of the video extensions the player understands
+    static bool isVideoFile(const QString &fileName);
+
+    // File name of the thumbnail that belongs to a video file name
+    static QString thumbnailNameFor(const QString &fileName);
+
+    // What a video and its thumbnail have in common: the file name without its extension, in lower case,
+    // so "clip.mp4" finds "clip.PNG" as well as "clip.png"
+    static QString thumbnailKeyFor(const QString &fileName);
+
+private:
+    // Where one file name lives in the name pool
+    struct NameSpan {
+        quint32 offset;  // First character in the pool
+        quint32 length;  // Number of characters
+    };
+
+    // File name of the video at the given index, without copying it out of the pool
+    QStringRef nameRef(int index) const;
+
+    // Library order: by name ignoring case, with an exact comparison to break ties
+    static bool lessByName(const QStringRef &a, const QStringRef &b);
+
+    // Natural-order sort key of a file name; comparing two keys bytewise compares the names
+    static QByteArray naturalKey(const QString &fileName);
+
+    // Whether the video at index a comes before the one at index b in natural name order
+    bool lessByKey(int a, int b) const;
+
+    // Rewrite the name and key pools without the entries of removed videos
+    void compactNames();
+
+    // Point the ids of the videos from the given index onwards at their current indices
+    void reindexIds(int from);
+
+    // Number of a codec name in the codec table, adding it if it is new
+    quint16 internCodec(const QString &name);
+
+    QString folder;                      // Absolute path of the library folder; the only directory the names share
+    QString names;                       // Every file name back to back, in insertion order
+    int deadNameChars = 0;               // Characters in the pool that belong to removed videos
+    QByteArray keys;                     // Every natural sort key back to back, in insertion order
+    QStringList codecNames{QString()};   // Every codec name seen so far, once; entry 0 means unknown
+
+    std::vector<int> idIndex;            // Current index of every id handed out since the last reset, -1 once removed
+    QHash<quint32, QString> thumbnailNames; // Thumbnail names other than thumbnailNameFor() the video, by id; rare
+
+    // One element per video, in display and playback order
+    std::vector<quint32> ids;            // Stable number of each video
+    std::vector<NameSpan> nameSpans;     // File name of each video in the pool
+    std::vector<quint64> keyPrefixes;    // First eight bytes of each sort key, big-endian, so most comparisons stop here
+    std::vector<NameSpan> keySpans;      // Sort key of each video in the key pool
+    std::vector<qint64> durations;       // Duration in milliseconds, or -1 while unknown
+    std::vector<qint64> thumbnailSizes;  // Size of the thumbnail file, or -1 when there is none
+    std::vector<qint64> thumbnailStamps; // Modification time of the thumbnail file (ms since epoch)
+    std::vector<int> views;              // Times each video has been played
+
+    // Colder fields, only read by the delegate and sorting
+    std::vector<qint64> fileSizes;       // Size of the video file
+    std::vector<qint64> fileStamps;      // Modification time of the video file (ms since epoch)
+    std::vector<QSize> resolutions;      // Frame size, invalid while unknown
+    std::vector<quint16> videoCodecs;    // Video codec, as an index into codecNames
+    std::vector<quint16> audioCodecs;    // Audio codec, as an index into codecNames
+    std::vector<qint64> bitRates;        // Bit rate in bits per second, or -1 while unknown
+    std::vector<qint64> createdTimes;    // Creation time (ms since epoch), or -1 while unknown
+};
+
+#endif // MEDIALIBRARY_H
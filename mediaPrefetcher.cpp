@@ -0,0 +1,173 @@
+#include "mediaPrefetcher.h"
+#include "mediaProbe.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRunnable>
+#include <QThread>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
+namespace {
+
+const qint64 defaultBandwidth = 32 * 1024 * 1024;  // Leaves most of a spinning disk to the video that is playing
+const qint64 chunkBytes = 256 * 1024;              // Reads are advised, issued and paced in pieces of this size
+const int headSeconds = 4;                         // Playback time the head of a video should cover
+const qint64 minHeadBytes = 1024 * 1024;           // Enough for the headers and first frames of any video
+const qint64 maxHeadBytes = 16 * 1024 * 1024;      // Heads of very high bit rate videos are capped
+const qint64 defaultHeadBytes = 4 * 1024 * 1024;   // Used while a video's bit rate is unknown
+const qint64 maxIndexBytes = 8 * 1024 * 1024;      // Larger 'moov' boxes are left to the player
+
+}
+
+// Reads the head and index of one video; runs on the prefetcher's reading thread
+class PrefetchTask : public QRunnable
+{
+public:
+    PrefetchTask(MediaPrefetcher *prefetcher, const MediaPrefetcher::Request &request)
+        : prefetcher(prefetcher), request(request) {}
+
+    void run() override
+    {
+        qint64 bytes = 0;
+        QFile file(request.path);
+        if (file.open(QIODevice::ReadOnly)) {
+            QElapsedTimer clock;
+            clock.start();
+            bytes += fetch(&file, 0, qMin(file.size(), MediaPrefetcher::headBytes(request.bitRate)), bytes, clock);
+
+            // Files that were not written for streaming keep their index at the end, where the player looks first
+            qint64 offset = 0;
+            qint64 size = 0;
+            if (MediaProbe::findMovieBox(&file, &offset, &size) && offset >= bytes && size <= maxIndexBytes) {
+                bytes += fetch(&file, offset, size, bytes, clock);
+            }
+        }
+
+        MediaPrefetcher *target = prefetcher;
+        QString path = request.path;
+        QMetaObject::invokeMethod(prefetcher, [target, path, bytes]() {
+            target->fetched(path, bytes);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    // Read a range of the file into the page cache, no faster than the bandwidth allows; returns the bytes read
+    qint64 fetch(QFile *file, qint64 offset, qint64 length, qint64 alreadyRead, const QElapsedTimer &clock)
+    {
+        if (length <= 0 || !file->seek(offset)) {
+            return 0;
+        }
+
+        QByteArray chunk(int(chunkBytes), Qt::Uninitialized);
+        qint64 read = 0;
+        while (read < length) {
+            qint64 piece = qMin(chunkBytes, length - read);
+#ifdef Q_OS_LINUX
+            // Let the kernel queue the piece after this one while this one is being read
+            qint64 next = qMin(chunkBytes, length - read - piece);
+            if (next > 0) {
+                posix_fadvise(file->handle(), offset + read + piece, next, POSIX_FADV_WILLNEED);
+            }
+#endif
+            qint64 got = file->read(chunk.data(), piece);
+            if (got <= 0) {
+                break;
+            }
+            read += got;
+
+            // Sleep off whatever is ahead of the budget
+            qint64 dueMs = (alreadyRead + read) * 1000 / qMax<qint64>(1, prefetcher->bandwidth);
+            if (dueMs > clock.elapsed()) {
+                QThread::msleep(quint64(dueMs - clock.elapsed()));
+            }
+        }
+        return read;
+    }
+
+    MediaPrefetcher *prefetcher;        // Prefetcher that receives the result
+    MediaPrefetcher::Request request;   // Video to fetch
+};
+
+MediaPrefetcher::MediaPrefetcher(QObject *parent)
+    : QObject(parent),
+    bandwidth(defaultBandwidth)
+{
+    // One reader: parallel reads would only make a spinning disk seek back and forth
+    pool.setMaxThreadCount(1);
+
+    int bandwidthMb = qEnvironmentVariableIntValue("TOMEO_READAHEAD_MBPS");
+    if (bandwidthMb > 0) {
+        setBandwidth(qint64(bandwidthMb) * 1024 * 1024);
+    }
+}
+
+MediaPrefetcher::~MediaPrefetcher()
+{
+    queue.clear();
+    pool.waitForDone();  // The running read still references this prefetcher
+}
+
+void MediaPrefetcher::prefetch(const QList<Request> &requests)
+{
+    // Fetched videos that are no longer wanted cannot count as hits anymore
+    QSet<QString> wanted;
+    for (const Request &request : requests) {
+        wanted.insert(request.path);
+    }
+    done.intersect(wanted);
+
+    queue.clear();
+    for (const Request &request : requests) {
+        if (!done.contains(request.path) && request.path != current) {
+            queue.append(request);
+        }
+    }
+    dispatch();
+}
+
+void MediaPrefetcher::cancelAll()
+{
+    queue.clear();
+    done.clear();
+}
+
+void MediaPrefetcher::notePlayed(const QString &path)
+{
+    if (done.remove(path)) {
+        hits++;
+    } else {
+        misses++;  // Still queued, being read, or never asked for
+    }
+}
+
+void MediaPrefetcher::dispatch()
+{
+    if (running || queue.isEmpty()) {
+        return;
+    }
+    running = true;
+    Request request = queue.takeFirst();
+    current = request.path;
+    pool.start(new PrefetchTask(this, request));
+}
+
+void MediaPrefetcher::fetched(const QString &path, qint64 bytes)
+{
+    running = false;
+    current.clear();
+    fetchedBytes += bytes;
+    if (bytes > 0) {
+        done.insert(path);
+    }
+    dispatch();
+}
+
+qint64 MediaPrefetcher::headBytes(qint64 bitRate)
+{
+    if (bitRate <= 0) {
+        return defaultHeadBytes;
+    }
+    return qBound(minHeadBytes, bitRate / 8 * headSeconds, maxHeadBytes);
+}
@@ -0,0 +1,77 @@
+#ifndef MEDIAPREFETCHER_H
+#define MEDIAPREFETCHER_H
+
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <atomic>
+
+// MediaPrefetcher pulls the start of the videos the user is likely to play next into
+// the operating system's page cache, so a cold file on a spinning disk or a network
+// mount does not stall the first frames. For each video it reads the head, and the
+// 'moov' index of ISO media files when that sits at the end, on a single background
+// thread: the kernel is asked to read ahead, and the ranges are then read at a pace
+// that stays within a bandwidth budget. Hit and miss counters record how often a
+// played video had been fetched in time.
+class MediaPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    // A video worth fetching
+    struct Request {
+        QString path;        // Absolute path of the video
+        qint64 bitRate = -1; // Bit rate in bits per second, used to size the head; -1 when unknown
+    };
+
+    // Constructor: creates the reading thread
+    explicit MediaPrefetcher(QObject *parent = nullptr);
+
+    // Destructor: drops queued reads and waits for the running one
+    ~MediaPrefetcher();
+
+    // Fetch the given videos, most likely first; queued videos not among them are dropped
+    void prefetch(const QList<Request> &requests);
+
+    // Drop every queued read and forget what has been fetched
+    void cancelAll();
+
+    // Record that the video at the given path is being played, counting a hit if it had been fetched
+    void notePlayed(const QString &path);
+
+    // Bytes per second the reads may take together; defaults to TOMEO_READAHEAD_MBPS when set
+    void setBandwidth(qint64 bytesPerSecond) { bandwidth = bytesPerSecond; }
+
+    // Played videos that had been fetched, and those that had not
+    int hitCount() const { return hits; }
+    int missCount() const { return misses; }
+
+    // Bytes read ahead so far
+    qint64 bytesFetched() const { return fetchedBytes; }
+
+private:
+    friend class PrefetchTask;
+
+    // Hand the next queued video to the reading thread
+    void dispatch();
+
+    // Called on the GUI thread when a video has been fetched
+    void fetched(const QString &path, qint64 bytes);
+
+    // Bytes of the start of a video to fetch: a few seconds of playback at its bit rate
+    static qint64 headBytes(qint64 bitRate);
+
+    QThreadPool pool;                     // The reading thread
+    QList<Request> queue;                 // Videos not fetched yet, most likely first
+    bool running = false;                 // Whether a read is in progress
+    QString current;                      // Path being read
+    QSet<QString> done;                   // Videos fetched and not played yet
+    std::atomic<qint64> bandwidth;        // Read pace in bytes per second
+    int hits = 0;                         // Played videos that had been fetched
+    int misses = 0;                       // Played videos that had not
+    qint64 fetchedBytes = 0;              // Bytes read ahead so far
+};
+
+#endif // MEDIAPREFETCHER_H
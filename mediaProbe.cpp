@@ -0,0 +1,205 @@
+#include "mediaProbe.h"
+#include <QFile>
+#include <QHash>
+#include <QVector>
+#include <QtEndian>
+
+namespace {
+
+const qint64 maxMovieBox = 64 * 1024 * 1024;  // Larger 'moov' boxes are not worth reading for a list entry
+const quint64 isoEpochOffset = 2082844800;    // Seconds from 1904-01-01, where ISO media times start, to 1970-01-01
+
+// One box inside a buffer: its type and where its payload lies
+struct Box {
+    QByteArray type;
+    int offset;
+    int size;
+};
+
+quint32 readU32(const QByteArray &data, int offset)
+{
+    return qFromBigEndian<quint32>(data.constData() + offset);
+}
+
+quint64 readU64(const QByteArray &data, int offset)
+{
+    return qFromBigEndian<quint64>(data.constData() + offset);
+}
+
+// The boxes directly inside the given range of the buffer; stops at the first corrupt one
+QVector<Box> children(const QByteArray &data, int begin, int end)
+{
+    QVector<Box> boxes;
+    int pos = begin;
+    while (pos + 8 <= end) {
+        quint64 size = readU32(data, pos);
+        int header = 8;
+        if (size == 1) {
+            if (pos + 16 > end) {
+                break;
+            }
+            size = readU64(data, pos + 8);
+            header = 16;
+        } else if (size == 0) {
+            size = quint64(end - pos);  // Runs to the end of its parent
+        }
+        if (size < quint64(header) || size > quint64(end - pos)) {
+            break;
+        }
+        boxes.append(Box{data.mid(pos + 4, 4), pos + header, int(size) - header});
+        pos += int(size);
+    }
+    return boxes;
+}
+
+QVector<Box> children(const QByteArray &data, const Box &parent)
+{
+    return children(data, parent.offset, parent.offset + parent.size);
+}
+
+// First box of the given type directly inside the parent; its size is -1 if there is none
+Box child(const QByteArray &data, const Box &parent, const char *type)
+{
+    for (const Box &box : children(data, parent)) {
+        if (box.type == type) {
+            return box;
+        }
+    }
+    return Box{QByteArray(), 0, -1};
+}
+
+}
+
+bool MediaProbe::probe(const QString &path, MediaLibrary::MediaInfo *info)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    qint64 offset = 0;
+    qint64 size = 0;
+    if (!findMovieBox(&file, &offset, &size) || size > maxMovieBox || !file.seek(offset)) {
+        return false;
+    }
+
+    QByteArray movie = file.read(size);
+    if (movie.size() != size || !parseMovie(movie, info)) {
+        return false;
+    }
+
+    // Containers rarely record an overall bit rate, but size over duration is what matters for streaming
+    if (info->duration > 0) {
+        info->bitRate = file.size() * 8 * 1000 / info->duration;
+    }
+    return true;
+}
+
+bool MediaProbe::findMovieBox(QIODevice *device, qint64 *offset, qint64 *size)
+{
+    static const QList<QByteArray> leadingTypes = {"ftyp", "moov", "mdat", "free", "skip", "wide", "pnot"};
+
+    // Only box headers are read; 'mdat' and friends are skipped over with a seek
+    qint64 pos = 0;
+    qint64 end = device->size();
+    while (pos + 8 <= end) {
+        if (!device->seek(pos)) {
+            return false;
+        }
+        QByteArray header = device->read(16);
+        if (header.size() < 8) {
+            return false;
+        }
+
+        quint64 boxSize = readU32(header, 0);
+        QByteArray type = header.mid(4, 4);
+        int headerSize = 8;
+        if (boxSize == 1) {
+            if (header.size() < 16) {
+                return false;
+            }
+            boxSize = readU64(header, 8);
+            headerSize = 16;
+        } else if (boxSize == 0) {
+            boxSize = quint64(end - pos);
+        }
+        if (boxSize < quint64(headerSize) || (pos == 0 && !leadingTypes.contains(type))) {
+            return false;  // Corrupt, or not an ISO media file at all (AVI, Matroska, ...)
+        }
+
+        if (type == "moov") {
+            *offset = pos + headerSize;
+            *size = qint64(boxSize) - headerSize;
+            return true;
+        }
+        pos += qint64(boxSize);
+    }
+    return false;
+}
+
+bool MediaProbe::parseMovie(const QByteArray &movie, MediaLibrary::MediaInfo *info)
+{
+    bool foundHeader = false;
+    for (const Box &box : children(movie, 0, movie.size())) {
+        if (box.type == "mvhd" && box.size >= 20) {
+            // Version 1 headers use 64-bit times and durations
+            quint8 version = quint8(movie.at(box.offset));
+            quint64 creation;
+            quint32 timescale;
+            quint64 duration;
+            if (version == 1 && box.size >= 32) {
+                creation = readU64(movie, box.offset + 4);
+                timescale = readU32(movie, box.offset + 20);
+                duration = readU64(movie, box.offset + 24);
+            } else {
+                creation = readU32(movie, box.offset + 4);
+                timescale = readU32(movie, box.offset + 12);
+                duration = readU32(movie, box.offset + 16);
+            }
+
+            if (timescale > 0) {
+                info->duration = qint64(double(duration) * 1000 / timescale);
+            }
+            if (creation > isoEpochOffset) {
+                info->created = qint64(creation - isoEpochOffset) * 1000;
+            }
+            foundHeader = true;
+        } else if (box.type == "trak") {
+            Box media = child(movie, box, "mdia");
+            Box handler = media.size >= 0 ? child(movie, media, "hdlr") : media;
+            Box mediaInfo = media.size >= 0 ? child(movie, media, "minf") : media;
+            Box sampleTable = mediaInfo.size >= 0 ? child(movie, mediaInfo, "stbl") : mediaInfo;
+            Box sampleDescription = sampleTable.size >= 0 ? child(movie, sampleTable, "stsd") : sampleTable;
+            if (handler.size < 12 || sampleDescription.size < 16) {
+                continue;
+            }
+
+            // The first sample entry names the codec; video entries also carry the frame size
+            QByteArray handlerType = movie.mid(handler.offset + 8, 4);
+            int entry = sampleDescription.offset + 8;
+            QString codec = codecName(movie.mid(entry + 4, 4));
+            if (handlerType == "vide" && info->videoCodec.isEmpty()) {
+                info->videoCodec = codec;
+                if (sampleDescription.size >= 8 + 36) {
+                    info->resolution = QSize(qFromBigEndian<quint16>(movie.constData() + entry + 32),
+                                             qFromBigEndian<quint16>(movie.constData() + entry + 34));
+                }
+            } else if (handlerType == "soun" && info->audioCodec.isEmpty()) {
+                info->audioCodec = codec;
+            }
+        }
+    }
+    return foundHeader;
+}
+
+QString MediaProbe::codecName(const QByteArray &fourcc)
+{
+    static const QHash<QByteArray, QString> names = {
+        {"avc1", "H.264"}, {"avc3", "H.264"}, {"hvc1", "HEVC"}, {"hev1", "HEVC"},
+        {"av01", "AV1"}, {"vp09", "VP9"}, {"mp4v", "MPEG-4"}, {"jpeg", "Motion JPEG"},
+        {"apcn", "ProRes"}, {"apch", "ProRes"}, {"apcs", "ProRes"}, {"apco", "ProRes"},
+        {"mp4a", "AAC"}, {"ac-3", "AC-3"}, {"ec-3", "E-AC-3"}, {"Opus", "Opus"},
+        {"fLaC", "FLAC"}, {"alac", "ALAC"}, {".mp3", "MP3"}, {"lpcm", "PCM"}, {"sowt", "PCM"}, {"twos", "PCM"}
+    };
+    return names.value(fourcc, QString::fromLatin1(fourcc).trimmed());
+}
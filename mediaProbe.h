@@ -0,0 +1,31 @@
+#ifndef MEDIAPROBE_H
+#define MEDIAPROBE_H
+
+#include <QByteArray>
+#include <QString>
+#include "mediaLibrary.h"
+
+class QIODevice;
+
+// MediaProbe reads the technical details of a video straight from its container,
+// without starting a decoder. It understands the ISO base media format (.mp4, .mov
+// and friends), where everything needed sits in the 'moov' box, and only reads that
+// box. Other containers are left to the media backend (see MediaIndexer).
+class MediaProbe
+{
+public:
+    // Fill in the details of the video at the given path; returns false if the container is not understood
+    static bool probe(const QString &path, MediaLibrary::MediaInfo *info);
+
+    // Find the 'moov' box of an ISO media file; returns false if there is none
+    static bool findMovieBox(QIODevice *device, qint64 *offset, qint64 *size);
+
+private:
+    // Parse the contents of a 'moov' box
+    static bool parseMovie(const QByteArray &movie, MediaLibrary::MediaInfo *info);
+
+    // Readable name for a sample entry type such as "avc1" or "mp4a"
+    static QString codecName(const QByteArray &fourcc);
+};
+
+#endif // MEDIAPROBE_H
@@ -0,0 +1,171 @@
+#include "mediaScanner.h"
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QMultiHash>
+#include <QRunnable>
+#include <QThread>
+#include <algorithm>
+
+namespace {
+
+const size_t batchSize = 64;     // Videos per batch before it is sent to the GUI thread, at first
+const size_t batchGrowth = 4;    // Later batches hold a quarter of what was delivered before them
+const qint64 batchDelayMs = 100; // A partial batch is sent anyway after this long
+
+}
+
+// One walk over a folder; runs on one of the scanner's worker threads
+class ScanTask : public QRunnable
+{
+public:
+    ScanTask(MediaScanner *scanner, const QString &folder, std::shared_ptr<std::atomic_bool> cancelled, int throttleMs)
+        : scanner(scanner), folder(folder), cancelled(cancelled), throttleMs(throttleMs) {}
+
+    void run() override
+    {
+        if (!QDir(folder).exists()) {
+            deliverFinished(false);
+            return;
+        }
+
+        QHash<QString, QFileInfo> thumbnails;  // Thumbnails seen so far, by thumbnail key
+        QMultiHash<QString, QFileInfo> waiting; // Videos whose thumbnail has not come up yet, by thumbnail key
+        QElapsedTimer sinceLastBatch;
+        sinceLastBatch.start();
+
+        // One walk over the folder picks up the videos and their thumbnails together
+        QDirIterator it(folder, QDir::Files);
+        while (it.hasNext()) {
+            if (*cancelled) {
+                return;
+            }
+
+            it.next();
+            if (throttleMs > 0) {
+                QThread::msleep(throttleMs);  // Pretend to be a slow network share
+            }
+
+            QString name = it.fileName();
+            if (MediaLibrary::isVideoFile(name)) {
+                QString key = MediaLibrary::thumbnailKeyFor(name);
+                auto thumb = thumbnails.constFind(key);
+                if (thumb != thumbnails.constEnd()) {
+                    batch.push_back(videoWithThumbnail(it.fileInfo(), *thumb));
+                } else {
+                    waiting.insert(key, it.fileInfo());  // Its thumbnail may still turn up later in the walk
+                }
+            } else if (name.endsWith(".png", Qt::CaseInsensitive)) {
+                // Matched whatever the case of its suffix; its real name is kept for loading it
+                QFileInfo info = it.fileInfo();
+                QString key = MediaLibrary::thumbnailKeyFor(name);
+                thumbnails.insert(key, info);
+                for (const QFileInfo &video : waiting.values(key)) {
+                    batch.push_back(videoWithThumbnail(video, info));
+                }
+                waiting.remove(key);
+            }
+
+            // Every batch is merged into the whole library, so batches grow with it
+            size_t fullBatch = std::max(batchSize, delivered / batchGrowth);
+            if (batch.size() >= fullBatch || (!batch.empty() && sinceLastBatch.elapsed() >= batchDelayMs)) {
+                deliverBatch();
+                sinceLastBatch.restart();
+            }
+        }
+
+        // Whatever is still waiting has no thumbnail at all
+        for (auto video = waiting.constBegin(); video != waiting.constEnd(); ++video) {
+            const QFileInfo &info = video.value();
+            batch.push_back(MediaLibrary::ScannedVideo{info.fileName(), info.size(), info.lastModified().toMSecsSinceEpoch(), -1, 0, QString()});
+        }
+
+        deliverBatch();
+        deliverFinished(true);
+    }
+
+private:
+    static MediaLibrary::ScannedVideo videoWithThumbnail(const QFileInfo &video, const QFileInfo &thumbnail)
+    {
+        QString thumbnailName = thumbnail.fileName();
+        if (thumbnailName == MediaLibrary::thumbnailNameFor(video.fileName())) {
+            thumbnailName.clear();  // The usual name is not stored
+        }
+        return MediaLibrary::ScannedVideo{video.fileName(), video.size(), video.lastModified().toMSecsSinceEpoch(),
+                                          thumbnail.size(), thumbnail.lastModified().toMSecsSinceEpoch(), thumbnailName};
+    }
+
+    // Hand the current batch to the GUI thread, unless this scan has been cancelled in the meantime
+    void deliverBatch()
+    {
+        if (batch.empty()) {
+            return;
+        }
+
+        MediaScanner *target = scanner;
+        QString path = folder;
+        std::shared_ptr<std::atomic_bool> flag = cancelled;
+        std::vector<MediaLibrary::ScannedVideo> videos;
+        videos.swap(batch);
+        delivered += videos.size();
+        QMetaObject::invokeMethod(scanner, [target, path, flag, videos]() {
+            if (!*flag) {
+                emit target->batchFound(path, videos);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+    void deliverFinished(bool folderFound)
+    {
+        MediaScanner *target = scanner;
+        QString path = folder;
+        std::shared_ptr<std::atomic_bool> flag = cancelled;
+        QMetaObject::invokeMethod(scanner, [target, path, flag, folderFound]() {
+            if (!*flag) {
+                target->scanning = false;
+                emit target->finished(path, folderFound);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+    MediaScanner *scanner;                        // Scanner that receives the results
+    QString folder;                               // Folder being walked
+    std::shared_ptr<std::atomic_bool> cancelled;  // Set when this scan should stop
+    int throttleMs;                               // Artificial delay per directory entry
+    std::vector<MediaLibrary::ScannedVideo> batch; // Videos found since the last delivery
+    size_t delivered = 0;                         // Videos handed to the GUI thread so far
+};
+
+MediaScanner::MediaScanner(QObject *parent)
+    : QObject(parent)
+{
+    // A cancelled walk may still be stuck in a slow directory read while the next one starts
+    pool.setMaxThreadCount(2);
+    throttleMs = qEnvironmentVariableIntValue("TOMEO_SCAN_THROTTLE_MS");
+}
+
+MediaScanner::~MediaScanner()
+{
+    cancel();
+    pool.waitForDone();  // Running walks still reference this scanner
+}
+
+void MediaScanner::start(const QString &folderPath)
+{
+    cancel();
+
+    cancelled = std::make_shared<std::atomic_bool>(false);
+    scanning = true;
+    pool.start(new ScanTask(this, QDir(folderPath).absolutePath(), cancelled, throttleMs));
+}
+
+void MediaScanner::cancel()
+{
+    if (cancelled) {
+        *cancelled = true;
+    }
+    scanning = false;
+}
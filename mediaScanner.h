@@ -0,0 +1,55 @@
+#ifndef MEDIASCANNER_H
+#define MEDIASCANNER_H
+
+#include "mediaLibrary.h"
+#include <QObject>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// MediaScanner walks a video folder on a background thread and streams what it
+// finds back to the GUI thread in batches, small at first and growing with what has
+// been found, so merging them into the library stays cheap. A scan can be cancelled at any
+// time, and starting a new one cancels the one before it. For testing against
+// slow storage, TOMEO_SCAN_THROTTLE_MS adds an artificial delay per directory entry.
+class MediaScanner : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Constructor: reads the artificial throttle from the environment
+    explicit MediaScanner(QObject *parent = nullptr);
+
+    // Destructor: cancels the running scan and waits for the worker to notice
+    ~MediaScanner();
+
+    // Start walking the folder, cancelling any scan still in progress
+    void start(const QString &folderPath);
+
+    // Stop the running scan; nothing more is delivered from it
+    void cancel();
+
+    // Whether a scan has been started and has not finished or been cancelled yet
+    bool isScanning() const { return scanning; }
+
+    // Delay added after every directory entry, to simulate slow storage
+    void setThrottle(int msPerEntry) { throttleMs = msPerEntry; }
+
+signals:
+    // Emitted on the GUI thread with the next few videos found, each with its thumbnail details
+    void batchFound(const QString &folderPath, const std::vector<MediaLibrary::ScannedVideo> &videos);
+
+    // Emitted on the GUI thread once the whole folder has been walked
+    void finished(const QString &folderPath, bool folderFound);
+
+private:
+    friend class ScanTask;
+
+    QThreadPool pool;                                 // Worker threads used for walking folders
+    std::shared_ptr<std::atomic_bool> cancelled;      // Cancellation flag of the current scan
+    bool scanning = false;                            // Whether a scan is in progress
+    int throttleMs = 0;                               // Artificial delay per directory entry
+};
+
+#endif // MEDIASCANNER_H
@@ -1,18 +1,40 @@
-#include "mySlider.h"
-
-void MySlider::mousePressEvent(QMouseEvent *ev)
-{
-    // First, call the parent class's mouse press event to ensure normal slider behavior,
-    // so that the dragging functionality is not affected.
-    QSlider::mousePressEvent(ev);
-
-    // Get the mouse position. We can't directly get it from the event (ev)
-    // because the starting position of the mouse is not useful when dragging.
-    double pos = ev->pos().x() / (double)width();
-
-    // Calculate the new slider value based on the mouse position, then set the slider's value
-    setValue(pos * (maximum() - minimum()) + minimum());
-
-    // Emit a custom signal when the slider is clicked
-    emit costomSliderClicked();
-}
+#include "mySlider.h"
+
+void MySlider::mousePressEvent(QMouseEvent *ev)
+{
+    // First, call the parent class's mouse press event to ensure normal slider behavior,
+    // so that the dragging functionality is not affected.
+    QSlider::mousePressEvent(ev);
+
+    // Get the mouse position. We can't directly get it from the event (ev)
+    // because the starting position of the mouse is not useful when dragging.
+    double pos = ev->pos().x() / (double)width();
+
+    // Calculate the new slider value based on the mouse position, then set the slider's value
+    setValue(pos * (maximum() - minimum()) + minimum());
+
+    // Emit a custom signal when the slider is clicked
+    emit costomSliderClicked();
+}
+
+void MySlider::mouseMoveEvent(QMouseEvent *ev)
+{
+    // Keep the normal dragging behaviour
+    QSlider::mouseMoveEvent(ev);
+
+    // While dragging the handle is where the value is; while hovering it is wherever the mouse is
+    emit sliderHovered(isSliderDown() ? value() : valueAt(ev->pos().x()));
+}
+
+void MySlider::leaveEvent(QEvent *ev)
+{
+    QSlider::leaveEvent(ev);
+    emit hoverLeft();
+}
+
+int MySlider::valueAt(int x) const
+{
+    // The same mapping mousePressEvent uses for clicks
+    double pos = qBound(0.0, x / (double)width(), 1.0);
+    return pos * (maximum() - minimum()) + minimum();
+}
@@ -13,16 +13,33 @@ class MySlider : public QSlider
 public:
     // Constructor: Initializes the custom slider
     MySlider(QWidget *parent = 0) : QSlider(parent)
-    {}
+    {
+        setMouseTracking(true);  // Hovering reports positions too, not just dragging
+    }
+
+    // Slider value under the given horizontal position
+    int valueAt(int x) const;
 
 protected:
     // Override mousePressEvent to capture mouse press events on the slider
     void mousePressEvent(QMouseEvent *ev) override;
 
+    // Override mouseMoveEvent to report the value under the mouse while hovering
+    void mouseMoveEvent(QMouseEvent *ev) override;
+
+    // Override leaveEvent to report the mouse leaving the slider
+    void leaveEvent(QEvent *ev) override;
+
 signals:
     // Custom signal to notify when the slider is clicked by the user
     void costomSliderClicked();  // This signal is emitted when the slider is clicked
 
+    // Emitted with the value under the mouse while it moves over the slider, dragging or not
+    void sliderHovered(int value);
+
+    // Emitted when the mouse leaves the slider
+    void hoverLeft();
+
 };
 
 #endif // MYSLIDER_H
@@ -1,795 +1,953 @@
-#include "player.h"
-#include "button.h"
-#include "mainwindow.h"
-#include <QDir>
-#include <QMessageBox>
-#include <QDirIterator>
-#include <QImageReader>
-#include <QPropertyAnimation>
-#include <QMediaMetaData>
-#include <QFontDatabase>
-#include <QRandomGenerator>
-#include <QScrollBar>
-
-
-// Function to read video files and thumbnails from the specified directory
-std::vector<TheButtonInfo> getInfoIn(std::string loc) {
-
-    std::vector<TheButtonInfo> out = std::vector<TheButtonInfo>();  // Vector to store video info
-    QDir dir(QString::fromStdString(loc));  // Open the directory
-    QDirIterator it(dir);  // Create an iterator to loop through files in the directory
-
-    QString defaultThumb = ":/default.png";  // Path to the default thumbnail image (resource path or file path)
-
-    while (it.hasNext()) { // Iterate through all files in the directory
-
-        QString f = it.next();  // Get the current file
-
-        if (f.contains("."))  // Check if the file has an extension (not a directory)
-
-#if defined(_WIN32)
-            if (f.contains(".wmv") || f.contains(".mp4") || f.contains(".MOV")) {  // Windows platforms
-#else
-            if (f.contains(".wmv") || f.contains(".mp4") || f.contains(".MOV")) {  // macOS/Linux platforms
-#endif
-
-                // Construct the expected thumbnail filename by replacing the video file extension with .png
-                QString thumb = f.left(f.length() - 4) + ".png";
-                QImage sprite;
-
-                // Check if the thumbnail file exists and is valid
-                if (QFile(thumb).exists()) {
-                    QImageReader imageReader(thumb);
-                    sprite = imageReader.read();  // Read the image data
-                    if (sprite.isNull()) {
-                        qDebug() << "Warning: Couldn't process thumbnail " << thumb << ", using default thumbnail.";
-                        sprite = QImage(defaultThumb);  // Load the default thumbnail if the image is invalid
-                    }
-                } else {
-                    qDebug() << "Warning: Thumbnail not found for " << f << ", using default thumbnail.";
-                    sprite = QImage(defaultThumb);  // Use the default thumbnail if the file doesn't exist
-                }
-
-                // Create an icon from the image for the button
-                QIcon* ico = new QIcon(QPixmap::fromImage(sprite));
-                QUrl* url = new QUrl(QUrl::fromLocalFile(f));  // Convert the file path to a URL
-                out.push_back(TheButtonInfo(url, ico));  // Add the video and thumbnail info to the output list
-            }
-    }
-
-    return out;  // Return the list of video info with URLs and icons
-}
-
-
-// Function to load videos from a folder and populate the player UI with thumbnails and titles
-void Player::loadVideosFromFolder(const QString &folderPath)
-{
-    QDir dir(folderPath);
-    if (!dir.exists()) {  // Check if the directory exists
-        qDebug() << "Directory does not exist";
-        const int result = QMessageBox::information(
-            NULL,
-            QString("Tomeo"),
-            QString("Directory does not exist! Add command line argument to \"quoted\" file location."));
-        exit(-1);  // Exit the program with error code -1 if the directory is invalid
-    }
-
-    // Get all video files (e.g., mp4 format) from the directory
-    QStringList filters;
-    filters << "*.mp4" << "*.avi" << "*.mkv" << "*.MOV" << "*.wmv";  // Add more formats as needed
-    QStringList videoFiles = dir.entryList(filters, QDir::Files);
-
-    // If no video files were found, show a message and exit the program
-    if (videoFiles.isEmpty()) {
-        const int result = QMessageBox::information(
-            NULL,
-            QString("Tomeo"),
-            QString("No videos found! Add command line argument to \"quoted\" file location."));
-        exit(-1);  // Exit the program with error code -1
-    }
-
-    // Get video information, including URLs and thumbnails
-    std::vector<TheButtonInfo> videos = getInfoIn(folderPath.toStdString());
-
-    playerList->clear();
-    player_ui->listWidget->clear();  // Clear the existing list widget items
-
-    // Add the video files to the media player playlist
-    foreach (const QString &fileName, videoFiles) {
-        QUrl url = QUrl::fromLocalFile(dir.filePath(fileName));  // Get the full file path as URL
-        playerList->addMedia(url);  // Add the video to the playlist
-    }
-
-    // Set the size for each ListWidget item
-    int itemHeight = 120;  // Set item height for each video
-    player_ui->listWidget->setIconSize(QSize(200, 200));  // Set the size of the video thumbnail
-    player_ui->listWidget->setStyleSheet("QListWidget::item { height: " + QString::number(itemHeight) + "px; }");  // Set the height of list items
-
-    // Set up font for the view count icon
-    int fontId = QFontDatabase::addApplicationFont(":/iconfont.ttf");
-    QString fontName = QFontDatabase::applicationFontFamilies(fontId).at(0);
-    QFont viewIconFont = QFont(fontName);
-    viewIconFont.setPixelSize(30);  // Set font size for the view count icon
-
-    // Loop through each video to create the list widget items with thumbnails and titles
-    for (const TheButtonInfo &videoInfo : videos) {
-        // Create a new QListWidgetItem
-        QListWidgetItem *item = new QListWidgetItem();
-
-        // Create a QWidget to contain the custom item layout
-        QWidget *itemWidget = new QWidget(player_ui->listWidget);
-
-        // Create the outer horizontal layout for the item
-        QHBoxLayout *outerLayout = new QHBoxLayout();
-
-        // Create QLabel to display the video thumbnail
-        QLabel *thumbnailLabel = new QLabel(itemWidget);
-        thumbnailLabel->setPixmap(videoInfo.icon->pixmap(150, 120));  // Set the thumbnail image
-        thumbnailLabel->setFixedSize(150, 120);  // Set fixed size for the thumbnail
-        thumbnailLabel->setStyleSheet("border: none; padding: 0;");  // Remove borders and padding
-
-        // Create vertical layout for the video title and view count
-        QVBoxLayout *textLayout = new QVBoxLayout();
-
-        // Create QLabel to display the video title
-        QLabel *titleLabel = new QLabel(videoInfo.url->fileName(), itemWidget);
-        QFont titleFont("Comic Sans MS", 12, QFont::Bold);  // Set font for the title
-        titleLabel->setFont(titleFont);
-        titleLabel->setStyleSheet("color: white;");  // Set the font color of the title
-        titleLabel->setWordWrap(true);  // Allow title to wrap if it's too long
-
-        // Create a horizontal layout to display the view count icon and label
-        QHBoxLayout *viewCountLayout = new QHBoxLayout();
-
-        // Create QLabel for the view count icon
-        QLabel *viewIconLabel = new QLabel(itemWidget);
-        viewIconLabel->setText(QChar(0xe603));  // Set the view count icon (using Unicode character)
-        viewIconLabel->setFont(viewIconFont);
-        viewIconLabel->setStyleSheet("color: pink;");  // Set color for the view count icon
-
-        // Create QLabel for the view count text (using random values for demonstration)
-        int randomViews = QRandomGenerator::global()->bounded(1000, 10000);  // Random view count
-        QLabel *viewCountLabel = new QLabel("Views: " + QString::number(randomViews), itemWidget);
-        QFont viewCountFont("Comic Sans MS", 8);  // Set font for the view count text
-        viewCountLabel->setFont(viewCountFont);
-        viewCountLabel->setStyleSheet("color: #D3D3D3;");  // Set the font color for the view count
-
-        // Add the view count icon and label to the horizontal layout
-        viewCountLayout->addWidget(viewIconLabel);
-        viewCountLayout->addWidget(viewCountLabel);
-
-        // Add the title label and view count layout to the vertical layout
-        textLayout->addWidget(titleLabel);
-        textLayout->addLayout(viewCountLayout);  // Add the view count layout
-
-        // Add the thumbnail label and text layout to the outer layout
-        outerLayout->addWidget(thumbnailLabel);
-        outerLayout->addLayout(textLayout);
-
-        // Set the layout of the item widget
-        itemWidget->setLayout(outerLayout);
-
-        // Set the size hint for the item
-        item->setSizeHint(itemWidget->sizeHint());
-
-        // Store the video URL in the item
-        item->setData(Qt::UserRole, *videoInfo.url);
-
-        // Add the item to the ListWidget
-        player_ui->listWidget->addItem(item);
-
-        // Set the custom QWidget as the item widget in the ListWidget
-        player_ui->listWidget->setItemWidget(item, itemWidget);
-    }
-
-    // If videos were found, start playing the first video in the playlist
-    if (!videoFiles.isEmpty()) {
-        togglePlayPause();
-
-        // Update the selection of the first video item in the ListWidget
-        QListWidgetItem *firstItem = player_ui->listWidget->item(currentVideoIndex);
-        firstItem->setSelected(true);  // Set the first item as selected
-    }
-}
-
-// Function to update the width of a child widget based on a percentage of the parent widget's width
-void Player::updateChildWidgetWidth(QWidget *parentWidget, QWidget *childWidget, double percentage)
-{
-    int parentWidth = parentWidget->width();  // Get the width of the parent widget
-    int childWidth = parentWidth * percentage;  // Calculate the child widget's width as a percentage of the parent
-    childWidget->setFixedWidth(childWidth);  // Set the width of the child widget
-}
-
-// Play button clicked: starts playing the video
-void Player::on_playButton_clicked()
-{
-    player->play();
-}
-
-// Pause button clicked: pauses the video
-void Player::on_pauseButton_clicked()
-{
-    player->pause();
-}
-
-// Next button clicked: plays the next video in the playlist
-void Player::on_nextButton_clicked()
-{
-    playNextVideo();
-}
-
-// Previous button clicked: plays the previous video in the playlist
-void Player::on_previousButton_clicked()
-{
-    playPreviousVideo();
-}
-
-// Timer update: updates the progress slider based on current playback position
-void Player::onTimerOut()
-{
-    int position = player->position();
-    int duration = player->duration();
-    if (position >= 0 && duration > 0) {
-        int sliderValue = static_cast<int>((position * maxValue) / duration);
-        player_ui->progressSlider->setValue(sliderValue);
-    }
-}
-
-// Fast forward button clicked: skips forward 5 seconds in the video
-void Player::onFastForward()
-{
-    // Get the current playback position
-    qint64 currentTime = player->position();
-
-    // Fast forward 5 seconds (5000 ms)
-    qint64 newTime = currentTime + 5000;
-
-    // Ensure the new time does not exceed the video duration
-    if (newTime < player->duration()) {
-        player->setPosition(newTime);
-    } else {
-        player->setPosition(player->duration());  // Go to the end of the video if new time exceeds duration
-    }
-}
-
-// Fast rewind button clicked: skips backward 5 seconds in the video
-void Player::onFastRewind()
-{
-    // Get the current playback position
-    qint64 currentTime = player->position();
-
-    // Rewind 5 seconds (5000 ms)
-    qint64 newTime = currentTime - 5000;
-
-    // Ensure the new time does not go below 0
-    if (newTime > 0) {
-        player->setPosition(newTime);
-    } else {
-        player->setPosition(0);  // Go to the start of the video if new time is less than 0
-    }
-}
-
-// Play the next video in the playlist
-void Player::playNextVideo()
-{
-    // If current video is the last one, loop back to the first video
-    if (currentVideoIndex == playerList->mediaCount() - 1) {
-        currentVideoIndex = 0;  // Go to the first video
-    } else {
-        currentVideoIndex++;  // Move to the next video
-    }
-
-    playerList->setCurrentIndex(currentVideoIndex);
-    player->play();
-    initData();
-    adjustPlayPause();
-
-
-    // Update the selected item in the list widget
-    player_ui->listWidget->clearSelection();
-    QListWidgetItem *item = player_ui->listWidget->item(currentVideoIndex);
-    item->setSelected(true);
-
-    // Log the name of the currently playing video
-    QString currentVideoName = playerList->currentMedia().QMediaContent::request().url().fileName();
-    qDebug() << "Current video: " << currentVideoName;
-}
-
-// Play the previous video in the playlist
-void Player::playPreviousVideo()
-{
-    // If current video is the first one, loop back to the last video
-    if (currentVideoIndex == 0) {
-        currentVideoIndex = playerList->mediaCount() - 1;  // Go to the last video
-    } else {
-        currentVideoIndex--;  // Move to the previous video
-    }
-
-    playerList->setCurrentIndex(currentVideoIndex);
-    player->play();
-    initData();
-    adjustPlayPause();
-
-    // Update the selected item in the list widget
-    player_ui->listWidget->clearSelection();
-    QListWidgetItem *item = player_ui->listWidget->item(currentVideoIndex);
-    item->setSelected(true);
-
-    // Log the name of the currently playing video
-    QString currentVideoName = playerList->currentMedia().QMediaContent::request().url().fileName();
-    qDebug() << "Current video: " << currentVideoName;
-
-    qDebug() << "Current index: " << currentVideoIndex;
-}
-
-// Toggle play/pause state and update the button text/icon accordingly
-void Player::togglePlayPause()
-{
-    if (player->state() == QMediaPlayer::PlayingState) {
-        player->pause();
-        player_ui->playPauseButton->setText(QChar(0xe633));  // Set pause icon
-    } else {
-        player->play();
-        player_ui->playPauseButton->setText(QChar(0xe628));  // Set play icon
-    }
-}
-
-void Player::adjustPlayPause()
-{
-    if (player->state() == QMediaPlayer::PlayingState) {
-        player_ui->playPauseButton->setText(QChar(0xe628));  // Set play icon
-    } else {
-        player_ui->playPauseButton->setText(QChar(0xe633));  // Set pause icon
-    }
-}
-
-
-
-// Set the volume of the player
-void Player::setVolume(int volume)
-{
-    player->setVolume(volume);  // Set the volume level
-}
-
-// Update the current time and total duration display on the UI
-void Player::updateTimeDisplay()
-{
-    int currentPosition = player->position();
-    int totalDuration = player->duration();
-
-    // Update the current time label
-    QTime currentTime(0, 0);
-    currentTime = currentTime.addMSecs(currentPosition);
-    player_ui->currentTimeLabel->setText(currentTime.toString("mm:ss /"));
-
-    // Update the total duration label
-    QTime totalTime(0, 0);
-    totalTime = totalTime.addMSecs(totalDuration);
-    player_ui->durationLabel->setText(totalTime.toString("mm:ss"));
-}
-
-// Handle video item click in the list widget
-void Player::onVideoItemClicked(QListWidgetItem *item)
-{
-    // Get the clicked item's index and update currentVideoIndex
-    int index = player_ui->listWidget->row(item);
-    currentVideoIndex = index;
-    playerList->setCurrentIndex(currentVideoIndex);
-
-    qDebug() << "Current index: " << currentVideoIndex;
-
-    player->play();
-
-    // Update the play/pause button icon to pause
-    player_ui->playPauseButton->setIcon(uiTool.pauseIcon);
-
-    // Update the selected item in the list widget
-    player_ui->listWidget->clearSelection();
-    item->setSelected(true);
-}
-
-// Handle progress slider click: jump to the new position
-void Player::onProgressSliderClicked()
-{
-    player->setPosition(player_ui->progressSlider->value() * player->duration() / maxValue);
-}
-
-// Handle progress slider movement: update position without timer interference
-void Player::onProgressSliderMoved()
-{
-    progressTimer->stop();
-    player->setPosition(player_ui->progressSlider->value() * player->duration() / maxValue);
-}
-
-// When the progress slider is released, start the timer again
-void Player::onProgressSliderReleased()
-{
-    progressTimer->start();
-}
-
-// Automatically play the next video when the current video ends
-void Player::onMediaStatusChanged(QMediaPlayer::MediaStatus status)
-{
-    if (status == QMediaPlayer::EndOfMedia) {
-        playNextVideo();  // Play the next video when the current one ends
-    }
-
-    adjustPlayPause();
-}
-
-// Volume slider changed: adjust the volume based on slider value
-void Player::onVolumeSliderChanged()
-{
-    int volumeValue = player_ui->volumeSlider->value();
-
-    if (volumeValue == 2) {
-        volumeValue = 0;  // Special handling for volume slider behavior
-    } else if (volumeValue == 1) {
-        volumeValue--;
-    }
-
-    player->setVolume(volumeValue);  // Set the volume to the new value
-
-    // Update the volume button icon depending on the volume level
-    if (volumeValue == 0) {
-        player_ui->volumeButton->setText(QChar(0xe652));  // Mute icon
-    } else {
-        player_ui->volumeButton->setText(QChar(0xe609));  // Normal volume icon
-    }
-}
-
-bool volumeState = true;  // Keeps track of whether the volume is muted or not
-
-// Handle volume button click: toggle mute/unmute
-void Player::onVolumeButtonClicked()
-{
-    int defaultVolume = 7;  // Default volume level
-
-    if (volumeState) {
-        previousVolume = player->volume();
-        player->setVolume(0);  // Mute the player
-        player_ui->volumeSlider->setValue(0);  // Set slider to 0 (mute)
-        player_ui->volumeButton->setText(QChar(0xe652));  // Mute icon
-    } else {
-        if (previousVolume == 0) {
-            player->setVolume(defaultVolume);  // Set to default volume if previously muted
-            player_ui->volumeSlider->setValue(defaultVolume);
-        } else {
-            player->setVolume(previousVolume);  // Restore previous volume
-            player_ui->volumeSlider->setValue(previousVolume);
-        }
-
-        player_ui->volumeButton->setText(QChar(0xe609));  // Normal volume icon
-    }
-
-    volumeState = !volumeState;  // Toggle the mute state
-}
-
-void Player::onLikeButtonCliked() {
-    // Get the current stylesheet of the like button
-    QString currentStyle = player_ui->likeButton->styleSheet();
-
-    // Check the current text color of the button; if it's lightgray, change it to red, otherwise set it to lightgray
-    if (currentStyle.contains("color: lightgray")) {
-        currentStyle.replace("color: lightgray", "color: red");
-    } else {
-        currentStyle.replace("color: red", "color: lightgray");
-    }
-
-    // Update the button's stylesheet with the new color
-    player_ui->likeButton->setStyleSheet(currentStyle);
-}
-
-void Player::onStarButtonCliked() {
-    // Get the current stylesheet of the star button
-    QString currentStyle = player_ui->starButton->styleSheet();
-
-    // Check the current text color of the button; if it's lightgray, change it to gold (#fdb702), otherwise set it to lightgray
-    if (currentStyle.contains("color: lightgray")) {
-        currentStyle.replace("color: lightgray", "color: #fdb702");
-    } else {
-        currentStyle.replace("color: #fdb702", "color: lightgray");
-    }
-
-    // Update the button's stylesheet with the new color
-    player_ui->starButton->setStyleSheet(currentStyle);
-}
-
-void Player::displayComment(QLabel* commentLabel, const QString& commentText)
-{
-    if (!commentLabel) return;  // Ensure the provided QLabel is not null
-
-    // Set the comment text on the label
-    commentLabel->setText(commentText);
-    commentLabel->setStyleSheet(
-        "color: white; "                       // Text color (white)
-        "font-size: 22px; "                    // Font size
-        "font-family: 'Comic Sans MS'; "       // Font style (can use simpler fonts like Arial)
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "   stop:0 rgba(255, 105, 180, 200), "  // Gradient color (from pink to deep pink)
-        "   stop:1 rgba(255, 182, 193, 180)); " // End color (light pink)
-        "border: 2px solid rgba(255, 105, 180, 200); "  // Border color matching the gradient
-        "padding: 10px 15px; "                 // Padding (10px top-bottom, 15px left-right)
-        "opacity: 0.9; "                       // Set opacity for a softer background color
-        "text-align: left;"                    // Text alignment (can be changed to center if needed)
-        );
-
-    commentLabel->raise();  // Bring the label to the front
-    commentLabel->setAlignment(Qt::AlignCenter);
-
-    commentLabel->adjustSize();  // Adjust size to fit content
-
-    // Ensure label does not exceed the width of the video widget
-    int maxWidth = player_ui->videoWidget->width();
-    int labelWidth = commentLabel->width();
-    if (labelWidth > maxWidth) {
-        commentLabel->setFixedWidth(maxWidth);  // Set max width for the label
-    }
-
-    // Generate a random Y position within the top portion of the video widget
-    int randomY = qrand() % (player_ui->videoWidget->height() / 3);  // Random Y position within top 1/3
-
-    // Set the initial position of the comment label: outside the right edge of the video widget
-    commentLabel->move(player_ui->videoWidget->width(), randomY);
-
-    // Use QPropertyAnimation to animate the label from right to left
-    animateComment(commentLabel);
-
-    // Clear the comment input area
-    player_ui->commentArea->clear();
-}
-
-void Player::onShareButtonClicked()
-{
-    // Show a message box indicating that the share was successful
-    const int result = QMessageBox::information(
-        NULL,
-        QString("Tomeo"),
-        QString("Share Successful!"));
-}
-
-void Player::onSendButtonClicked()
-{
-    // Get the comment text from the input area
-    QString commentText = player_ui->commentArea->toPlainText();
-    if (commentText.isEmpty()) {
-        return;  // Do nothing if the comment is empty
-    }
-
-    // Add the comment to the comment list
-    addComment("You", commentText, ":/avatar6.png", getCurrentTime());
-
-    // Set the scroll bar value to the maximum, so it scrolls to the bottom
-    QScrollBar *scrollBar = player_ui->commentList->verticalScrollBar();
-    scrollBar->setValue(scrollBar->maximum());
-
-    bool foundEmptyLabel = false;
-    QLabel* availableLabel = nullptr;
-
-    // Find an available QLabel to display the comment
-    if (!foundEmptyLabel && player_ui->commentLabel1->text().isEmpty()) {
-        availableLabel = player_ui->commentLabel1;
-        foundEmptyLabel = true;
-    } else if (!foundEmptyLabel && player_ui->commentLabel2->text().isEmpty()) {
-        availableLabel = player_ui->commentLabel2;
-        foundEmptyLabel = true;
-    } else if (!foundEmptyLabel && player_ui->commentLabel3->text().isEmpty()) {
-        availableLabel = player_ui->commentLabel3;
-        foundEmptyLabel = true;
-    } else if (!foundEmptyLabel && player_ui->commentLabel4->text().isEmpty()) {
-        availableLabel = player_ui->commentLabel4;
-        foundEmptyLabel = true;
-    } else if (!foundEmptyLabel && player_ui->commentLabel5->text().isEmpty()) {
-        availableLabel = player_ui->commentLabel5;
-        foundEmptyLabel = true;
-    } else if (!foundEmptyLabel && player_ui->commentLabel6->text().isEmpty()) {
-        availableLabel = player_ui->commentLabel6;
-        foundEmptyLabel = true;
-    } else if (!foundEmptyLabel && player_ui->commentLabel7->text().isEmpty()) {
-        availableLabel = player_ui->commentLabel7;
-        foundEmptyLabel = true;
-    } else if (!foundEmptyLabel && player_ui->commentLabel8->text().isEmpty()) {
-        availableLabel = player_ui->commentLabel8;
-        foundEmptyLabel = true;
-    } else if (!foundEmptyLabel && player_ui->commentLabel9->text().isEmpty()) {
-        availableLabel = player_ui->commentLabel9;
-        foundEmptyLabel = true;
-    } else if (!foundEmptyLabel && player_ui->commentLabel10->text().isEmpty()) {
-        availableLabel = player_ui->commentLabel10;
-        foundEmptyLabel = true;
-    }
-
-    // If an available label is found, display the comment
-    if (availableLabel) {
-        displayComment(availableLabel, commentText);
-    }
-}
-
-void Player::animateComment(QLabel *commentLabel)
-{
-    // Create an animation for the comment label
-    QPropertyAnimation *animation = new QPropertyAnimation(commentLabel, "pos");
-    animation->setDuration(12000);  // Set the animation duration to 12 seconds
-    animation->setStartValue(QPoint(player_ui->videoWidget->width(), commentLabel->y()));  // Start at the right edge with a random Y position
-    animation->setEndValue(QPoint(-commentLabel->width(), commentLabel->y()));  // End at the left edge with the same Y position
-
-    // Set the easing curve for the animation to make it non-linear
-    animation->setEasingCurve(QEasingCurve::Linear);
-
-    // Connect the animation finished signal to clear the label's text after the animation is complete
-    connect(animation, &QPropertyAnimation::finished, this, [commentLabel]() {
-        commentLabel->clear();  // Clear the comment text after the animation finishes
-    });
-
-    // Start the animation and delete it when finished
-    animation->start(QAbstractAnimation::DeleteWhenStopped);
-}
-
-void Player::updateVideoTitle()
-{
-    int fontId = QFontDatabase::addApplicationFont(":/iconfont.ttf");  // Load the font file
-    QString fontName = QFontDatabase::applicationFontFamilies(fontId).at(0);  // Get the font family name
-    QFont watchIconFont = QFont(fontName);  // Create a font object for action icons
-    watchIconFont.setPixelSize(30);
-
-    player_ui->watchIcon->setStyleSheet(
-        "QLabel {"
-        "   color: white;"                       // Set the text color of the button to white
-        "   background-color: transparent;"      // Set the background color to transparent
-        "   border: none;"                       // No border around the button
-        "}");
-
-    player_ui->watchLabel->setStyleSheet(
-        "QLabel {"
-        "   font-family: 'Comic Sans MS';"
-        "   color: white;"                       // Set the text color of the button to white
-        "   background-color: transparent;"      // Set the background color to transparent
-        "   border: none;"                       // No border around the button
-        "   font-size: 30px;"
-        "}");
-
-    // Get the current video filename from the media player
-    QString currentVideoName = playerList->currentMedia().QMediaContent::request().url().fileName();
-    player_ui->videoLabel->setText("Currently Playing: " + currentVideoName);  // Display the video name in the UI
-
-    int randomViewers = QRandomGenerator::global()->bounded(50, 1000);  // 生成50到1000之间的随机数
-    player_ui->watchIcon->setFont(watchIconFont);
-    player_ui->watchIcon->setText(QChar(0xe61d));
-    player_ui->watchLabel->setText(QString::number(randomViewers) + " people are watching");
-
-    qDebug() << currentVideoName;  // Log the video name for debugging purposes
-}
-
-void Player::addComment(const QString &username, const QString &commentText, const QString &avatarPath, const QString &timestamp)
-{
-    CommentData data = {username, commentText, avatarPath, timestamp};  // Create a CommentData structure
-
-    // Create a new QListWidgetItem to represent the comment
-    QListWidgetItem *item = new QListWidgetItem();
-
-    // Create a custom widget to display the comment
-    QWidget *commentWidget = createCommentWidget(data);
-
-    // Set the size hint for the item, so it matches the width of the comment list widget
-    item->setSizeHint(QSize(player_ui->commentList->width() - 20, commentWidget->sizeHint().height()));
-
-    // Add the item and the widget to the comment list
-    player_ui->commentList->addItem(item);
-    player_ui->commentList->setItemWidget(item, commentWidget);
-}
-
-QWidget* Player::createCommentWidget(const CommentData &data) {
-    // Create the outer widget to contain the comment
-    QWidget *commentWidget = new QWidget();
-    commentWidget->setStyleSheet("background-color: #f0f0f0; border-radius: 10px; padding: 10px;");
-
-    // Create a vertical layout for the comment
-    QVBoxLayout *mainLayout = new QVBoxLayout(commentWidget);
-
-    // ====================== Avatar and Username Section ======================
-    QHBoxLayout *headerLayout = new QHBoxLayout();
-    headerLayout->setSpacing(10);  // Set the spacing between avatar and username
-
-    // Avatar image
-    QLabel *avatarLabel = new QLabel(commentWidget);
-    avatarLabel->setPixmap(QPixmap(data.avatarPath).scaled(80, 80, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    avatarLabel->setFixedSize(80, 80);
-    avatarLabel->setStyleSheet("border-radius: 5px;");  // Make the avatar round
-
-    // Username label
-    QLabel *usernameLabel = new QLabel(data.username, commentWidget);
-    usernameLabel->setObjectName(QString("usernameLabel_%1").arg(data.username));
-    usernameLabel->setStyleSheet(
-        "font-family: 'Comic Sans MS';"
-        "font-weight: bold;"
-        "font-style: italic;"
-        "color: #333333;"
-        "font-size: 36px;"
-        "over-flow: "
-        );
-
-    // Add avatar and username to the header layout
-    headerLayout->addWidget(avatarLabel);
-    headerLayout->addWidget(usernameLabel);
-    headerLayout->addStretch();  // Add stretch space to align the avatar and username to the left
-
-    // ====================== Comment Text Section ======================
-    QLabel *commentTextLabel = new QLabel(data.commentText, commentWidget);
-    commentTextLabel->setWordWrap(true);  // Allow the text to wrap
-    commentTextLabel->setStyleSheet(
-        "font-family: 'Comic Sans MS';"
-        "color: #555555;"
-        "font-size: 24px;"
-        );
-    commentTextLabel->setMinimumHeight(120);  // Set the minimum height for the comment text
-
-    // ====================== Timestamp Section ======================
-    QLabel *timestampLabel = new QLabel(data.timestamp, commentWidget);
-    timestampLabel->setStyleSheet(
-        "font-family: 'Comic Sans MS';"
-        "color: #999999;"
-        "font-size: 16px;"
-        );
-
-    // ====================== Add all sections to the main layout ======================
-    mainLayout->addLayout(headerLayout);     // Add avatar and username section
-    mainLayout->addWidget(commentTextLabel); // Add comment text section
-    mainLayout->addWidget(timestampLabel);   // Add timestamp section
-
-    return commentWidget;  // Return the completed widget
-}
-
-void Player::initComments() {
-    // Initialize the comments by adding sample data
-    addComment("Alice", "This video is awesome! 😍", ":/avatar1.png", "2024-06-01 10:30");
-    addComment("Bob", "I totally agree with you!", ":/avatar2.png", "2024-06-01 11:00");
-    addComment("Charlie", "This part made me laugh 😂", ":/avatar3.png", "2024-06-01 11:15");
-    addComment("David", "Amazing content, keep it up!", ":/avatar4.png", "2024-06-01 11:45");
-    addComment("Eve", "Can't stop watching this! 🤩", ":/avatar5.png", "2024-06-01 12:00");
-}
-
-void Player::onSpeedButtonClicked()
-{
-    // Toggle playback speed based on the current rate
-    if (currentPlaybackRate == 1.0) {
-        currentPlaybackRate = 1.5;  // Set playback rate to 1.5x
-        player_ui->speedButton->setText("1.5x");
-    } else if (currentPlaybackRate == 1.5) {
-        currentPlaybackRate = 2.0;  // Set playback rate to 2.0x
-        player_ui->speedButton->setText("2.0x");
-    } else {
-        currentPlaybackRate = 1.0;  // Reset to 1.0x speed
-        player_ui->speedButton->setText("1.0x");
-    }
-
-    // Set the playback speed for the media player
-    player->setPlaybackRate(currentPlaybackRate);
-}
-
-QString Player::getCurrentTime() {
-    // Get the current system time
-    QDateTime currentDateTime = QDateTime::currentDateTime();
-
-    // Format the time as a string
-    QString formattedTime = currentDateTime.toString("yyyy-MM-dd HH:mm");
-
-    return formattedTime;  // Return the formatted current time
-}
-
-void Player::initData()
-{
-    double randomLike = QRandomGenerator::global()->generateDouble() * (100.0 - 50.0);
-    randomLike = floor(randomLike * 10 + 0.5) / 10.0;  // 保留一位小数
-
-    double randomStar = QRandomGenerator::global()->generateDouble() * (30.0 - 5.0);;
-    randomStar = floor(randomStar * 10) / 10.0;
-
-    double randomComment = QRandomGenerator::global()->generateDouble() * (10.0 - 5.0);;
-    randomComment = floor(randomComment * 10) / 10.0;
-
-    player_ui->likeCount->setText(QString::number(randomLike, 'f', 1) + "k");
-
-    player_ui->starCount->setText(QString::number(randomStar, 'f', 1) + "k");
-
-    player_ui->commentCount->setText(QString::number(randomComment, 'f', 1) + "k");
-}
+#include "player.h"
+#include "mainwindow.h"
+#include "avatarCache.h"
+#include <QMessageBox>
+#include <QMediaMetaData>
+#include <QFileInfo>
+#include <QFontDatabase>
+#include <QRandomGenerator>
+#include <QStyle>
+#include <QWindow>
+
+namespace {
+
+const qint64 commentSeekThreshold = 3000;  // A position step longer than this is a seek, not playback
+
+}
+
+Player::~Player()
+{
+    // Children are deleted in the order they were created, which would take the filter first
+    delete ingest;
+    delete commentStore;
+}
+
+// Function to start loading videos from a folder. The folder is walked on a background thread
+// and the playlist and list widget fill up batch by batch, so the window is usable right away.
+void Player::loadVideosFromFolder(const QString &folderPath)
+{
+    // Any decode still queued or running for a previous folder belongs to rows that are about to go away
+    thumbnailLoader->reset();
+    indexer->cancelAll();
+    readAhead->cancelAll();
+
+    videoModel->resetLibrary(folderPath);  // Clear the existing list rows
+    playerPool->clear();
+    playbackStarted = false;
+    currentVideoIndex = 0;
+    currentRemoved = false;
+
+    // Comments belong to a video of the old folder
+    commentVideo.clear();
+    commentModel->clear();
+    danmaku->clear();
+
+    // From now on, changes to the folder are applied as small diffs instead of a full reload
+    if (!folderWatcher->directories().isEmpty()) {
+        folderWatcher->removePaths(folderWatcher->directories());
+    }
+    folderWatcher->addPath(library.folderPath());
+
+    // Walk the folder once in the background; rows are added as batches arrive
+    scanSeen.clear();
+    scanAdded.clear();
+    scanner->start(library.folderPath());
+}
+
+// Start playing the first video once the first batch of a fresh folder has arrived
+void Player::startPlaybackIfIdle()
+{
+    if (playbackStarted || library.count() == 0) {
+        return;
+    }
+    playbackStarted = true;
+
+    currentVideoIndex = 0;
+    setActivePlayer(playerPool->activate({library.url(currentVideoIndex), library.resolution(currentVideoIndex)}));
+    togglePlayPause();
+    loadComments();
+
+    // Update the selection of the first video item in the list
+    selectVideoRow(currentVideoIndex);
+    warmNeighbours();
+}
+
+// Select the list row of the library entry at the given index
+void Player::selectVideoRow(int index)
+{
+    // A video hidden by the search has no row; nothing is selected then, nor for an index of -1
+    int row = index >= 0 && index < library.count() ? videoModel->rowOf(index) : -1;
+    QItemSelectionModel *selection = player_ui->listWidget->selectionModel();
+    if (row < 0) {
+        selection->clear();
+    } else {
+        selection->setCurrentIndex(videoModel->index(row), QItemSelectionModel::ClearAndSelect);
+    }
+}
+
+// Library index of the video the given number of rows away from the playing one, wrapping around
+int Player::neighbourVideo(int step) const
+{
+    // After the playing video has left the library, the one that took its place comes next
+    if (currentRemoved && step > 0) {
+        step--;
+    }
+
+    int rows = videoModel->rowCount();
+    int row = videoModel->rowOf(currentVideoIndex);
+    if (row < 0 || rows == 0) {
+        // The playing video is hidden by the search, so walk the whole library instead
+        return (currentVideoIndex + step + library.count()) % library.count();
+    }
+    return videoModel->libraryIndex((row + step + rows) % rows);
+}
+
+// The folder watcher fires once per file operation, so wait for the burst to settle before rescanning
+void Player::onFolderChanged()
+{
+    rescanTimer->start();
+}
+
+// Walk the folder again in the background; the results are merged into the library as they arrive
+void Player::applyFolderChanges()
+{
+    scanSeen.clear();
+    scanAdded.clear();
+    scanner->start(library.folderPath());  // Restarts the walk if one is still running
+}
+
+// Merge a batch of scanned videos into the library, touching only what is new or changed
+void Player::onScanBatch(const QString &folderPath, const std::vector<MediaLibrary::ScannedVideo> &videos)
+{
+    if (folderPath != library.folderPath()) {
+        return;  // Left over from a folder that has since been replaced
+    }
+
+    std::vector<MediaLibrary::ScannedVideo> added;
+    for (const MediaLibrary::ScannedVideo &video : videos) {
+        scanSeen.insert(video.fileName);
+        int index = library.indexOf(video.fileName);
+
+        if (index < 0) {
+            added.push_back(video);  // New (or renamed-to) video; the batch is slotted in together below
+            scanAdded.insert(qMakePair(video.fileSize, video.fileModified), video.fileName);
+            continue;
+        }
+
+        if (library.fileSize(index) != video.fileSize || library.fileModified(index) != video.fileModified) {
+            // A rewritten video is probed again; its catalogue entry no longer matches
+            videoModel->setFileStamp(index, video.fileSize, video.fileModified);
+            indexer->index(library.filePath(index), video.fileSize, video.fileModified);
+        }
+        if (library.thumbnailSize(index) != video.thumbnailSize
+                || library.thumbnailModified(index) != video.thumbnailModified
+                || library.thumbnailName(index) != video.thumbnailName) {
+            // Only a changed thumbnail is decoded again; the cache misses on the new size and mtime, or name
+            library.setThumbnail(index, video.thumbnailSize, video.thumbnailModified, video.thumbnailName);
+            videoModel->dropThumbnail(video.fileName);
+            prefetcher->schedule();
+        }
+    }
+
+    // New videos go in at their sorted positions in one merge, which moves the playing one along
+    if (!added.empty()) {
+        std::vector<int> moved = videoModel->addVideos(added);
+        if (playbackStarted && currentVideoIndex < int(moved.size())) {
+            currentVideoIndex = moved[currentVideoIndex];
+        }
+        // The rows are usable right away; the prefetcher loads their thumbnails once they scroll near the screen
+        for (const MediaLibrary::ScannedVideo &video : added) {
+            indexer->index(library.filePath(library.indexOf(video.fileName)), video.fileSize, video.fileModified);
+        }
+    }
+
+    startPlaybackIfIdle();
+    warmNeighbours();  // New videos may have arrived next to the playing one
+}
+
+// Once the walk is complete, anything it did not see has been removed (or renamed away)
+void Player::onScanFinished(const QString &folderPath, bool folderFound)
+{
+    if (folderPath != library.folderPath()) {
+        return;
+    }
+
+    if (!folderFound && !playbackStarted) {
+        qDebug() << "Directory does not exist";
+        const int result = QMessageBox::information(
+            NULL,
+            QString("Tomeo"),
+            QString("Directory does not exist! Add command line argument to \"quoted\" file location."));
+        exit(-1);  // Exit the program with error code -1 if the directory is invalid
+    }
+
+    // From the back, so the remaining indices stay valid
+    for (int index = library.count() - 1; index >= 0; --index) {
+        if (!scanSeen.contains(library.fileName(index))) {
+            removeVideoRow(index);
+        }
+    }
+
+    // If no video files were found, show a message and exit the program
+    if (library.count() == 0 && !playbackStarted) {
+        const int result = QMessageBox::information(
+            NULL,
+            QString("Tomeo"),
+            QString("No videos found! Add command line argument to \"quoted\" file location."));
+        exit(-1);  // Exit the program with error code -1
+    }
+}
+
+// Remove one video from the playlist and the list, keeping the playing video where it is.
+// Playback is never interrupted: a renamed video plays on under its new name, and a deleted one
+// plays on from the open file until the user moves on.
+void Player::removeVideoRow(int index)
+{
+    bool wasPlaying = playbackStarted && !currentRemoved && index == currentVideoIndex;
+    int renamed = wasPlaying ? renamedTo(index) : -1;
+
+    indexer->forget(library.filePath(index));  // A renamed video's entry has already moved to its new name
+    videoModel->removeVideo(index);
+
+    if (!playbackStarted) {
+        return;
+    } else if (renamed >= 0) {
+        currentVideoIndex = renamed > index ? renamed - 1 : renamed;
+        selectVideoRow(currentVideoIndex);
+    } else if (index < currentVideoIndex) {
+        currentVideoIndex--;  // The playing video moved up one row
+    } else if (wasPlaying) {
+        currentRemoved = true;
+        player_ui->listWidget->selectionModel()->clear();
+    }
+    if (currentRemoved && currentVideoIndex >= library.count()) {
+        currentVideoIndex = 0;  // The last row went; the next video wraps around to the first
+    }
+    warmNeighbours();  // A warm player may hold the removed file
+}
+
+int Player::renamedTo(int index) const
+{
+    QString name = scanAdded.value(qMakePair(library.fileSize(index), library.fileModified(index)));
+    int renamed = name.isEmpty() ? -1 : library.indexOf(name);
+    return renamed != index ? renamed : -1;
+}
+
+// Make a player of the pool the one the controls, the progress bar and the time display follow
+void Player::setActivePlayer(QMediaPlayer *active)
+{
+    if (active == player) {
+        return;
+    }
+
+    // Warm players pause, load and stop in the background; only the one on screen is listened to
+    if (player) {
+        disconnect(player, nullptr, this, nullptr);
+    }
+    player = active;
+    seeker->setPlayer(player);
+    connect(player, &QMediaPlayer::mediaStatusChanged, this, &Player::onMediaStatusChanged);
+    if (windowShown) {
+        followPosition();
+    }
+    connect(player, &QMediaPlayer::durationChanged, this, &Player::updateTimeDisplay);
+    connect(player, &QMediaPlayer::durationChanged, this, &Player::updateNotifyInterval);
+    connect(player, &QMediaPlayer::durationChanged, this, &Player::requestPreviews);
+
+    // A warm player announced its duration before anyone was listening
+    updateNotifyInterval();
+    updateTimeDisplay();
+    updateProgress();
+    requestPreviews();
+}
+
+// Open the videos next to the playing one in the list as shown, the next one first,
+// and read the start of the few after them from disk
+void Player::warmNeighbours()
+{
+    QList<PlayerPool::Video> videos;
+    QList<MediaPrefetcher::Request> reads;
+    if (playbackStarted && library.count() > 1) {
+        for (int step : {1, -1, 2, 3, 4}) {
+            int index = neighbourVideo(step);
+            if (videos.size() < 3) {
+                videos.append({library.url(index), library.resolution(index)});
+            }
+            reads.append({library.filePath(index), library.bitRate(index)});
+        }
+    }
+    playerPool->warm(videos);
+    readAhead->prefetch(reads);
+}
+
+// Called on the GUI thread whenever a worker has finished decoding a thumbnail
+void Player::onThumbnailReady(const QString &fileName, const QImage &image)
+{
+    // Only the affected row is repainted
+    QPixmap pixmap = QPixmap::fromImage(image);
+    pixmap.setDevicePixelRatio(thumbnailLoader->devicePixelRatio());
+    videoModel->setThumbnail(fileName, pixmap);
+}
+
+void Player::onMediaInfo(const QString &path, const MediaLibrary::MediaInfo &info)
+{
+    QFileInfo file(path);
+    if (file.absolutePath() != library.folderPath()) {
+        return;  // From a folder that has since been replaced
+    }
+
+    int index = library.indexOf(file.fileName());
+    if (index >= 0) {
+        videoModel->setInfo(index, info);
+        if (index == currentVideoIndex && !currentRemoved) {
+            updateTimeDisplay();  // The duration can be shown before the player has worked it out
+        }
+    }
+}
+
+// Function to switch the list thumbnails to the size used by a window layout
+void Player::setThumbnailLevel(ThumbnailLoader::Level level)
+{
+    // Decode for the pixels of the screen the list is on, not for its logical size
+    qreal ratio = player_ui->listWidget->devicePixelRatioF();
+    if (!thumbnailLoader->setLevel(level, ratio)) {
+        return;  // Same layout on the same screen; resizes within one mode end here
+    }
+
+    QSize box = ThumbnailLoader::boxSize(level);
+    videoDelegate->setThumbnailBox(box);
+
+    // The placeholder shown until each thumbnail has been decoded in the background
+    QPixmap placeholder = QPixmap::fromImage(QImage(":/default.png").scaled(thumbnailLoader->pixelSize(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    placeholder.setDevicePixelRatio(ratio);
+    videoModel->setPlaceholder(placeholder);
+
+    // Thumbnails of the old size are replaced as the prefetcher reloads the rows on screen
+    videoModel->clearThumbnails();
+    prefetcher->schedule();
+}
+
+// Called when the window moves to another screen, and whenever it is shown
+void Player::onScreenChanged()
+{
+    setThumbnailLevel(thumbnailLoader->currentLevel());  // Nothing happens unless the pixel ratio changed
+}
+
+// Function to update the width of a child widget based on a percentage of the parent widget's width
+void Player::updateChildWidgetWidth(QWidget *parentWidget, QWidget *childWidget, double percentage)
+{
+    int parentWidth = parentWidget->width();  // Get the width of the parent widget
+    int childWidth = parentWidth * percentage;  // Calculate the child widget's width as a percentage of the parent
+    childWidget->setFixedWidth(childWidth);  // Set the width of the child widget
+}
+
+// Play button clicked: starts playing the video
+void Player::on_playButton_clicked()
+{
+    player->play();
+}
+
+// Pause button clicked: pauses the video
+void Player::on_pauseButton_clicked()
+{
+    player->pause();
+}
+
+// Next button clicked: plays the next video in the playlist
+void Player::on_nextButton_clicked()
+{
+    playNextVideo();
+}
+
+// Previous button clicked: plays the previous video in the playlist
+void Player::on_previousButton_clicked()
+{
+    playPreviousVideo();
+}
+
+// Position update: moves the progress slider to the current playback position
+void Player::updateProgress()
+{
+    MySlider *slider = player_ui->progressSlider;
+    if (!progressShown || slider->isSliderDown() || seeker->isBusy()) {
+        return;  // Off screen, held by the user, or the player still reports the position before a seek
+    }
+
+    qint64 position = player->position();
+    qint64 duration = player->duration();
+    if (position < 0 || duration <= 0) {
+        return;
+    }
+
+    // Setting a value restyles the whole slider, so only do it when the handle moves by a pixel
+    int sliderValue = static_cast<int>(position * maxValue / duration);
+    int pixel = QStyle::sliderPositionFromValue(0, maxValue, sliderValue, slider->width());
+    if (pixel != QStyle::sliderPositionFromValue(0, maxValue, slider->value(), slider->width())) {
+        slider->setValue(sliderValue);
+    }
+}
+
+// Ask for a position notification per pixel of handle movement while the progress bar is shown,
+// and only about once a second for the time display otherwise. Paused players send none at all.
+void Player::updateNotifyInterval()
+{
+    int interval = 1000;
+    qint64 duration = player->duration();
+    int width = player_ui->progressSlider->width();
+    if (progressShown && duration > 0 && width > 0) {
+        interval = static_cast<int>(qBound<qint64>(33, duration / width, 1000));  // No more often than a display refresh or two
+    }
+    if (player->notifyInterval() != interval) {
+        player->setNotifyInterval(interval);
+    }
+}
+
+void Player::followPosition()
+{
+    connect(player, &QMediaPlayer::positionChanged, this, &Player::updateTimeDisplay, Qt::UniqueConnection);
+    connect(player, &QMediaPlayer::positionChanged, this, &Player::updateProgress, Qt::UniqueConnection);
+    connect(player, &QMediaPlayer::positionChanged, this, &Player::syncComments, Qt::UniqueConnection);
+}
+
+// Preview frames are only extracted for the playing video, and only once its duration is known
+void Player::requestPreviews()
+{
+    if (!playbackStarted || currentRemoved || currentVideoIndex >= library.count()) {
+        return;
+    }
+    int index = currentVideoIndex;
+    previewer->request(library.filePath(index), library.fileSize(index), library.fileModified(index), player->duration());
+}
+
+// Show the frame for a slider value centred above that point of the progress bar
+void Player::showPreview(int value)
+{
+    previewValue = value;
+    const ScrubPreviewer::Sheet *sheet = nullptr;
+    if (playbackStarted && !currentRemoved && currentVideoIndex < library.count()) {
+        sheet = previewer->sheet(library.filePath(currentVideoIndex));
+    }
+    QImage frame = sheet ? sheet->frameAt(qint64(value) * player->duration() / maxValue) : QImage();
+    if (frame.isNull()) {
+        previewLabel->hide();  // Not extracted yet
+        return;
+    }
+
+    previewLabel->setPixmap(QPixmap::fromImage(frame));
+    previewLabel->adjustSize();
+
+    // Keep the whole frame inside the window
+    MySlider *slider = player_ui->progressSlider;
+    int x = QStyle::sliderPositionFromValue(slider->minimum(), slider->maximum(), value, slider->width());
+    QPoint anchor = slider->mapTo(player_ui->centralwidget, QPoint(x, 0));
+    int left = qBound(0, anchor.x() - previewLabel->width() / 2, player_ui->centralwidget->width() - previewLabel->width());
+    previewLabel->move(left, anchor.y() - previewLabel->height() - 6);
+    previewLabel->show();
+    previewLabel->raise();
+}
+
+void Player::hidePreview()
+{
+    previewValue = -1;
+    previewLabel->hide();
+}
+
+bool Player::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == player_ui->centralwidget->window()) {
+        bool shown = windowShown;
+        if (event->type() == QEvent::Show) {
+            // The native window only exists once the window is shown; it tells when the window changes screens
+            QWindow *handle = player_ui->centralwidget->window()->windowHandle();
+            if (handle) {
+                connect(handle, &QWindow::screenChanged, this, &Player::onScreenChanged, Qt::UniqueConnection);
+            }
+            onScreenChanged();  // The first show may already be on another screen than the list was set up for
+        }
+        if (event->type() == QEvent::Show || event->type() == QEvent::Hide) {
+            shown = event->type() == QEvent::Show && !player_ui->centralwidget->window()->isMinimized();
+        } else if (event->type() == QEvent::WindowStateChange) {
+            shown = player_ui->centralwidget->window()->isVisible() && !player_ui->centralwidget->window()->isMinimized();
+        }
+
+        // Position updates stop entirely while nobody can see them, and catch up once on return;
+        // comments that came due meanwhile are skipped like after a seek
+        if (shown != windowShown) {
+            windowShown = shown;
+            if (player && !windowShown) {
+                disconnect(player, &QMediaPlayer::positionChanged, this, nullptr);
+            } else if (player) {
+                followPosition();
+                updateTimeDisplay();
+                updateProgress();
+                syncComments(player->position());
+            }
+        }
+    } else if (watched == player_ui->progressSlider) {
+        // Minimizing the window sends hide events too, while isVisible() stays true
+        if (event->type() == QEvent::Show || event->type() == QEvent::Hide) {
+            progressShown = event->type() == QEvent::Show;
+            updateNotifyInterval();
+            updateProgress();
+        } else if (event->type() == QEvent::Resize) {
+            updateNotifyInterval();
+        }
+    }
+    return QMediaPlayer::eventFilter(watched, event);
+}
+
+// Fast forward button clicked: skips forward 5 seconds in the video
+void Player::onFastForward()
+{
+    // Get the current playback position
+    qint64 currentTime = player->position();
+
+    // Fast forward 5 seconds (5000 ms)
+    qint64 newTime = currentTime + 5000;
+
+    // Ensure the new time does not exceed the video duration
+    if (newTime < player->duration()) {
+        seeker->seek(newTime);
+    } else {
+        seeker->seek(player->duration());  // Go to the end of the video if new time exceeds duration
+    }
+}
+
+// Fast rewind button clicked: skips backward 5 seconds in the video
+void Player::onFastRewind()
+{
+    // Get the current playback position
+    qint64 currentTime = player->position();
+
+    // Rewind 5 seconds (5000 ms)
+    qint64 newTime = currentTime - 5000;
+
+    // Ensure the new time does not go below 0
+    if (newTime > 0) {
+        seeker->seek(newTime);
+    } else {
+        seeker->seek(0);  // Go to the start of the video if new time is less than 0
+    }
+}
+
+// Play the next video in the playlist
+void Player::playNextVideo()
+{
+    if (library.count() == 0) {
+        return;
+    }
+
+    // The next row of the list as shown; after the last one, loop back to the first
+    playVideoAt(neighbourVideo(1));
+}
+
+// Play the previous video in the playlist
+void Player::playPreviousVideo()
+{
+    if (library.count() == 0) {
+        return;
+    }
+
+    // The previous row of the list as shown; before the first one, loop back to the last
+    playVideoAt(neighbourVideo(-1));
+}
+
+// Switch playback to the library entry at the given index and select its list row
+void Player::playVideoAt(int index)
+{
+    if (index < 0 || index >= library.count()) {
+        return;
+    }
+
+    // A neighbour of the previous video is already open and showing its first frame
+    readAhead->notePlayed(library.filePath(index));
+    currentVideoIndex = index;
+    currentRemoved = false;
+
+    // Count the play; under "Most watched" the row may move up
+    MediaLibrary::MediaInfo info = library.info(index);
+    info.plays = indexer->notePlayed(library.filePath(index));
+    videoModel->setInfo(index, info);
+
+    setActivePlayer(playerPool->activate({library.url(index), library.resolution(index)}));
+    player->play();
+    initData();
+    adjustPlayPause();
+    loadComments();
+
+    // Update the selected row in the list, and open the videos around it
+    selectVideoRow(currentVideoIndex);
+    warmNeighbours();
+
+    // Log the name of the currently playing video
+    qDebug() << "Current video: " << library.fileName(currentVideoIndex);
+    qDebug() << "Current index: " << currentVideoIndex;
+    if (logCacheStats) {
+        qDebug() << "Read-ahead: " << readAhead->hitCount() << " hits, " << readAhead->missCount() << " misses";
+        qDebug() << "Avatars: " << AvatarCache::shared().hitCount() << " hits, " << AvatarCache::shared().missCount() << " misses";
+    }
+}
+
+// Toggle play/pause state and update the button text/icon accordingly
+void Player::togglePlayPause()
+{
+    if (player->state() == QMediaPlayer::PlayingState) {
+        player->pause();
+        player_ui->playPauseButton->setText(QChar(0xe633));  // Set pause icon
+    } else {
+        player->play();
+        player_ui->playPauseButton->setText(QChar(0xe628));  // Set play icon
+    }
+}
+
+void Player::adjustPlayPause()
+{
+    if (player->state() == QMediaPlayer::PlayingState) {
+        player_ui->playPauseButton->setText(QChar(0xe628));  // Set play icon
+    } else {
+        player_ui->playPauseButton->setText(QChar(0xe633));  // Set pause icon
+    }
+}
+
+
+
+// Set the volume of the player
+void Player::setVolume(int volume)
+{
+    player->setVolume(volume);  // Set the volume level
+}
+
+// Update the current time and total duration display on the UI
+void Player::updateTimeDisplay()
+{
+    qint64 currentPosition = player->position();
+    qint64 totalDuration = player->duration();
+    if (totalDuration <= 0 && !currentRemoved && currentVideoIndex < library.count()) {
+        totalDuration = qMax<qint64>(0, library.duration(currentVideoIndex));  // Known from the catalogue before the media has loaded
+    }
+
+    // Update the current time label
+    QTime currentTime(0, 0);
+    currentTime = currentTime.addMSecs(currentPosition);
+    player_ui->currentTimeLabel->setText(currentTime.toString("mm:ss /"));
+
+    // Update the total duration label
+    QTime totalTime(0, 0);
+    totalTime = totalTime.addMSecs(totalDuration);
+    player_ui->durationLabel->setText(totalTime.toString("mm:ss"));
+}
+
+// Handle video item click in the list
+void Player::onVideoItemClicked(const QModelIndex &index)
+{
+    // The search may hide rows, so map the row back to its library entry
+    playVideoAt(videoModel->libraryIndex(index.row()));
+}
+
+// Handle progress slider click: jump to the new position
+void Player::onProgressSliderClicked()
+{
+    seeker->seek(qint64(player_ui->progressSlider->value()) * player->duration() / maxValue);
+}
+
+// Handle progress slider movement: follow the drag with approximate seeks
+void Player::onProgressSliderMoved()
+{
+    seeker->scrub(qint64(player_ui->progressSlider->value()) * player->duration() / maxValue);
+}
+
+// When the progress slider is released, land exactly where it was let go
+void Player::onProgressSliderReleased()
+{
+    seeker->seek(qint64(player_ui->progressSlider->value()) * player->duration() / maxValue);
+}
+
+// Automatically play the next video when the current video ends
+void Player::onMediaStatusChanged(QMediaPlayer::MediaStatus status)
+{
+    if (status == QMediaPlayer::EndOfMedia) {
+        playNextVideo();  // Play the next video when the current one ends
+    }
+
+    adjustPlayPause();
+}
+
+// Volume slider changed: adjust the volume based on slider value
+void Player::onVolumeSliderChanged()
+{
+    int volumeValue = player_ui->volumeSlider->value();
+
+    if (volumeValue == 2) {
+        volumeValue = 0;  // Special handling for volume slider behavior
+    } else if (volumeValue == 1) {
+        volumeValue--;
+    }
+
+    player->setVolume(volumeValue);  // Set the volume to the new value
+
+    // Update the volume button icon depending on the volume level
+    if (volumeValue == 0) {
+        player_ui->volumeButton->setText(QChar(0xe652));  // Mute icon
+    } else {
+        player_ui->volumeButton->setText(QChar(0xe609));  // Normal volume icon
+    }
+}
+
+bool volumeState = true;  // Keeps track of whether the volume is muted or not
+
+// Handle volume button click: toggle mute/unmute
+void Player::onVolumeButtonClicked()
+{
+    int defaultVolume = 7;  // Default volume level
+
+    if (volumeState) {
+        previousVolume = player->volume();
+        player->setVolume(0);  // Mute the player
+        player_ui->volumeSlider->setValue(0);  // Set slider to 0 (mute)
+        player_ui->volumeButton->setText(QChar(0xe652));  // Mute icon
+    } else {
+        if (previousVolume == 0) {
+            player->setVolume(defaultVolume);  // Set to default volume if previously muted
+            player_ui->volumeSlider->setValue(defaultVolume);
+        } else {
+            player->setVolume(previousVolume);  // Restore previous volume
+            player_ui->volumeSlider->setValue(previousVolume);
+        }
+
+        player_ui->volumeButton->setText(QChar(0xe609));  // Normal volume icon
+    }
+
+    volumeState = !volumeState;  // Toggle the mute state
+}
+
+void Player::onLikeButtonCliked() {
+    // Get the current stylesheet of the like button
+    QString currentStyle = player_ui->likeButton->styleSheet();
+
+    // Check the current text color of the button; if it's lightgray, change it to red, otherwise set it to lightgray
+    if (currentStyle.contains("color: lightgray")) {
+        currentStyle.replace("color: lightgray", "color: red");
+    } else {
+        currentStyle.replace("color: red", "color: lightgray");
+    }
+
+    // Update the button's stylesheet with the new color
+    player_ui->likeButton->setStyleSheet(currentStyle);
+}
+
+void Player::onStarButtonCliked() {
+    // Get the current stylesheet of the star button
+    QString currentStyle = player_ui->starButton->styleSheet();
+
+    // Check the current text color of the button; if it's lightgray, change it to gold (#fdb702), otherwise set it to lightgray
+    if (currentStyle.contains("color: lightgray")) {
+        currentStyle.replace("color: lightgray", "color: #fdb702");
+    } else {
+        currentStyle.replace("color: #fdb702", "color: lightgray");
+    }
+
+    // Update the button's stylesheet with the new color
+    player_ui->starButton->setStyleSheet(currentStyle);
+}
+
+void Player::onShareButtonClicked()
+{
+    // Show a message box indicating that the share was successful
+    const int result = QMessageBox::information(
+        NULL,
+        QString("Tomeo"),
+        QString("Share Successful!"));
+}
+
+void Player::onSendButtonClicked()
+{
+    // Get the comment text from the input area
+    QString commentText = player_ui->commentArea->toPlainText();
+    if (commentText.isEmpty()) {
+        return;  // Do nothing if the comment is empty
+    }
+    if (commentFilter->blocks(commentText)) {
+        // Kept in the input area, so it can be reworded
+        QMessageBox::information(player_ui->commentArea, QString("Tomeo"), QString("Your comment contains a blocked word."));
+        return;
+    }
+
+    // Pin it to the moment it was launched up to, so it comes back at the same point of the video
+    CommentTrack::Comment comment;
+    comment.time = commentPosition;
+    comment.author = "You";
+    comment.text = commentText;
+    comment.avatarPath = ":/avatar6.png";
+    comment.posted = QDateTime::currentMSecsSinceEpoch();
+    int row = commentModel->addComment(comment);
+    if (row <= commentCursor) {
+        commentCursor++;  // It flies right now; the track must not launch it again
+    }
+    if (!commentVideo.isEmpty()) {
+        commentStore->append(commentVideo, comment);
+    }
+
+    // Show it in the comment panel, where it sits among the others by playback time
+    commentModel->fetchThrough(row);
+    player_ui->commentList->scrollTo(commentModel->index(row));
+
+    // Fly it across the video and clear the input area
+    danmaku->launch(commentText);
+    player_ui->commentArea->clear();
+}
+
+void Player::updateVideoTitle()
+{
+    int fontId = QFontDatabase::addApplicationFont(":/iconfont.ttf");  // Load the font file
+    QString fontName = QFontDatabase::applicationFontFamilies(fontId).at(0);  // Get the font family name
+    QFont watchIconFont = QFont(fontName);  // Create a font object for action icons
+    watchIconFont.setPixelSize(30);
+
+    player_ui->watchIcon->setStyleSheet(
+        "QLabel {"
+        "   color: white;"                       // Set the text color of the button to white
+        "   background-color: transparent;"      // Set the background color to transparent
+        "   border: none;"                       // No border around the button
+        "}");
+
+    player_ui->watchLabel->setStyleSheet(
+        "QLabel {"
+        "   font-family: 'Comic Sans MS';"
+        "   color: white;"                       // Set the text color of the button to white
+        "   background-color: transparent;"      // Set the background color to transparent
+        "   border: none;"                       // No border around the button
+        "   font-size: 30px;"
+        "}");
+
+    // Get the current video filename from the library
+    // A video that has left the library is still named after the file the player has open
+    QString currentVideoName = currentRemoved ? player->currentMedia().canonicalUrl().fileName()
+        : currentVideoIndex < library.count() ? library.fileName(currentVideoIndex) : QString();
+    player_ui->videoLabel->setText("Currently Playing: " + currentVideoName);  // Display the video name in the UI
+
+    int randomViewers = QRandomGenerator::global()->bounded(50, 1000);  // 生成50到1000之间的随机数
+    player_ui->watchIcon->setFont(watchIconFont);
+    player_ui->watchIcon->setText(QChar(0xe61d));
+    player_ui->watchLabel->setText(QString::number(randomViewers) + " people are watching");
+
+    qDebug() << currentVideoName;  // Log the video name for debugging purposes
+}
+
+// Show the comments of the playing video: drop those of the previous one and read its track
+void Player::loadComments()
+{
+    QString path = library.filePath(currentVideoIndex);
+    if (path == commentVideo) {
+        return;
+    }
+    commentVideo = path;
+    commentModel->clear();
+    commentCursor = 0;
+    commentPosition = player->position();
+    danmaku->clear();
+    commentStore->load(path);
+}
+
+// Take over the track of a video once it has been read
+void Player::onTrackLoaded(const QString &videoPath, std::shared_ptr<CommentTrack> track)
+{
+    if (videoPath != commentVideo) {
+        return;  // Another video has started meanwhile
+    }
+
+    // Comments sent while the log was being opened are kept; they are logged after it
+    for (int i = 0; i < comments.count(); ++i) {
+        track->insert(comments.comment(i));
+    }
+    commentModel->setTrack(std::move(*track));
+    commentCursor = comments.lowerBound(commentPosition + 1);
+}
+
+// Pin a frame's worth of live comments to the current position and fly them
+void Player::onLiveComments(const QVector<CommentIngest::Message> &messages)
+{
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    std::vector<CommentTrack::Comment> batch;
+    batch.reserve(size_t(messages.size()));
+    for (const CommentIngest::Message &message : messages) {
+        CommentTrack::Comment comment;
+        comment.time = commentPosition;
+        comment.author = message.author;
+        comment.text = message.text;
+        comment.avatarPath = ":/avatar1.png";
+        comment.posted = now;
+        batch.push_back(comment);
+    }
+
+    // The batch lands right at the cursor, and flies now rather than when the track reaches it
+    int first = commentModel->addComments(batch);
+    if (first <= commentCursor) {
+        commentCursor += int(batch.size());
+    }
+    // Only the overlay shows how many viewers sent the same words; the track and the log keep what was written
+    for (int i = 0; i < messages.size(); ++i) {
+        const CommentIngest::Message &message = messages.at(i);
+        danmaku->launch(message.repeats > 1 ? QString("%1 ×%2").arg(message.text).arg(message.repeats) : message.text);
+        if (!commentVideo.isEmpty()) {
+            commentStore->append(commentVideo, batch[size_t(i)]);
+        }
+    }
+}
+
+// Launch the comments due by the given playback position, or skip past them after a seek
+void Player::syncComments(qint64 position)
+{
+    // Playback moves forward by about one notification interval at a time; anything else is a seek
+    qint64 step = position - commentPosition;
+    commentPosition = position;
+    int due = comments.lowerBound(position + 1);
+    if (step < 0 || step > commentSeekThreshold) {
+        danmaku->clear();  // What was flying belongs to another part of the video
+        commentCursor = due;
+        return;
+    }
+
+    // Comments were checked when they were loaded or came in; a word blocked since then is caught here
+    for (; commentCursor < due; ++commentCursor) {
+        QString text = comments.text(commentCursor);
+        if (!commentFilter->blocks(text)) {
+            danmaku->launch(text);
+        }
+    }
+}
+
+void Player::onSpeedButtonClicked()
+{
+    // Toggle playback speed based on the current rate
+    if (currentPlaybackRate == 1.0) {
+        currentPlaybackRate = 1.5;  // Set playback rate to 1.5x
+        player_ui->speedButton->setText("1.5x");
+    } else if (currentPlaybackRate == 1.5) {
+        currentPlaybackRate = 2.0;  // Set playback rate to 2.0x
+        player_ui->speedButton->setText("2.0x");
+    } else {
+        currentPlaybackRate = 1.0;  // Reset to 1.0x speed
+        player_ui->speedButton->setText("1.0x");
+    }
+
+    // Set the playback speed for the media player
+    player->setPlaybackRate(currentPlaybackRate);
+}
+
+void Player::initData()
+{
+    double randomLike = QRandomGenerator::global()->generateDouble() * (100.0 - 50.0);
+    randomLike = floor(randomLike * 10 + 0.5) / 10.0;  // 保留一位小数
+
+    double randomStar = QRandomGenerator::global()->generateDouble() * (30.0 - 5.0);;
+    randomStar = floor(randomStar * 10) / 10.0;
+
+    double randomComment = QRandomGenerator::global()->generateDouble() * (10.0 - 5.0);;
+    randomComment = floor(randomComment * 10) / 10.0;
+
+    player_ui->likeCount->setText(QString::number(randomLike, 'f', 1) + "k");
+
+    player_ui->starCount->setText(QString::number(randomStar, 'f', 1) + "k");
+
+    player_ui->commentCount->setText(QString::number(randomComment, 'f', 1) + "k");
+}
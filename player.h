@@ -1,272 +1,450 @@
-#ifndef PLAYER_H
-#define PLAYER_H
-
-#include "ui_mainwindow.h"
-#include "tomeo_ui.h"
-#include "mySlider.h"
-#include <QMediaPlayer>
-#include <QMediaPlaylist>
-#include <QVideoWidget>
-#include <QListWidgetItem>
-#include "button.h"
-#include <QTimer.h>
-#include <QMessageBox>
-#include <QVBoxLayout>
-#include <QGraphicsOpacityEffect>
-
-// Structure to hold comment data including username, text, avatar, and timestamp
-struct CommentData {
-    QString username;     // Username of the commenter
-    QString commentText;  // The text of the comment
-    QString avatarPath;   // Path to the commenter's avatar image
-    QString timestamp;    // Timestamp of when the comment was posted
-};
-
-// Player class inherited from QMediaPlayer to manage video playback and related UI actions
-class Player : public QMediaPlayer {
-    Q_OBJECT
-
-public:
-    // Constructor initializes the player and sets up connections for UI elements
-    Player(Ui::MainWindow* ui, QWidget* parent)
-        :   QMediaPlayer(parent),
-        player_ui(ui),
-        uiTool(ui),
-        player(new QMediaPlayer(this)),
-        playerList(new QMediaPlaylist),
-        currentVideoIndex(0),
-        currentPlaybackRate(1.0)
-    {
-        // Place the QVideoWidget in a new QWidget container for better layout control
-        videoWidget = new QVideoWidget(player_ui->videoWidget); // Assign a new container for the video widget
-        videoWidget->resize(player_ui->videoWidget->size()); // Resize video widget to match the container's size
-
-        initComments(); // Initialize comments area and styles
-        initData();
-
-        // Set up a vertical layout to include the video widget and adjust layout margins
-        QVBoxLayout *layout = new QVBoxLayout(player_ui->videoWidget);
-        layout->addWidget(videoWidget);  // Add the video widget to the layout
-        layout->setContentsMargins(0, 0, 0, 0);  // Remove margins to allow video to fill the container
-        player_ui->videoWidget->setLayout(layout); // Set the layout for the video container
-
-        // Set up playlist and output for media playback
-        player->setPlaylist(playerList);
-        player->setVideoOutput(videoWidget);
-
-        // Update UI styles using helper functions
-        uiTool.updateProgressBarStyle();  // Set the style for the progress bar
-        uiTool.updateVolumeBarStyle();    // Set the style for the volume slider
-        uiTool.setCommentAreaStyle(400);  // Set the style for the comment area
-        uiTool.setVideoLabelStyle();      // Set the style for the video label
-
-        uiTool.setButtonSize();           // Set the size of the buttons
-        uiTool.loadIcon();                // Load the necessary icons
-        uiTool.setButtonStyle();          // Apply styles to buttons
-
-        // Connect button click events to the corresponding slots
-        connect(player_ui->speedButton, &QPushButton::clicked, this, &Player::onSpeedButtonClicked);
-
-        // Connect fast forward button click event
-        connect(player_ui->fastForwardButton, &QPushButton::clicked, this, &Player::onFastForward);
-
-        // Connect fast rewind button click event
-        connect(player_ui->fastRewindButton, &QPushButton::clicked, this, &Player::onFastRewind);
-
-        // Connect list widget item selection change to update video title
-        connect(player_ui->listWidget, &QListWidget::itemSelectionChanged,
-                this, &Player::updateVideoTitle);
-
-        // Connect other button events for like, star, share, and send actions
-        connect(player_ui->likeButton, &QPushButton::clicked, this, &Player::onLikeButtonCliked);
-        connect(player_ui->starButton, &QPushButton::clicked, this, &Player::onStarButtonCliked);
-        connect(player_ui->shareButton, &QPushButton::clicked, this, &Player::onShareButtonClicked);
-        connect(player_ui->sendButton, &QPushButton::clicked, this, &Player::onSendButtonClicked);
-
-        // Hide the comment section widgets initially
-        for (int i = 0; i < player_ui->commentLayout->count(); ++i) {
-            QWidget *widget = player_ui->commentLayout->itemAt(i)->widget();
-            if (widget) {
-                widget->hide();  // Hide comment widget
-            }
-            player_ui->closeCommentButton->hide();
-            player_ui->sayLabel->hide();
-        }
-
-        // Set the initial volume to 10% and update the volume slider
-        player->setVolume(10);  // Set initial volume level to 10%
-        player_ui->volumeSlider->setValue(10);
-
-        // Connect volume button to its respective slot
-        connect(player_ui->volumeButton, &QPushButton::clicked, this, &Player::onVolumeButtonClicked);
-
-        // Connect volume slider to change volume based on user interaction
-        connect(player_ui->volumeSlider, &MySlider::costomSliderClicked, this, &Player::onVolumeSliderChanged);
-        connect(player_ui->volumeSlider, &MySlider::sliderMoved, this, &Player::onVolumeSliderChanged);
-
-        // Set default state to pause for the play/pause button
-        // Connect the play/pause button to its respective slot
-        connect(player_ui->playPauseButton, &QPushButton::clicked, this, &Player::togglePlayPause);
-
-        // Connect next and previous buttons to their respective slots for video navigation
-        connect(player_ui->nextButton, &QPushButton::clicked, this, &Player::playNextVideo);
-        connect(player_ui->previousButton, &QPushButton::clicked, this, &Player::playPreviousVideo);
-
-        // Connect the progress slider to adjust the video position
-        connect(player_ui->progressSlider, &MySlider::costomSliderClicked, this, &Player::onProgressSliderClicked);
-        connect(player_ui->progressSlider, &MySlider::sliderMoved, this, &Player::onProgressSliderMoved);
-
-        // Connect slider released signal to update the video position once the slider is released
-        connect(player_ui->progressSlider, &MySlider::sliderReleased, this, &Player::onProgressSliderReleased);
-
-        // Set the range for the progress slider
-        player_ui->progressSlider->setRange(0, maxValue);
-
-        // Create a timer to regularly update the progress bar
-        progressTimer = new QTimer(this);
-        connect(progressTimer, &QTimer::timeout, this, &Player::onTimerOut);
-        progressTimer->setInterval(20);  // Set the timer interval to 20ms
-        progressTimer->start();          // Start the timer to periodically update the progress
-
-        // Connect signals for media status changes and updating time display
-        connect(player, &QMediaPlayer::mediaStatusChanged, this, &Player::onMediaStatusChanged);
-        connect(player, &QMediaPlayer::positionChanged, this, &Player::updateTimeDisplay);
-        connect(player, &QMediaPlayer::durationChanged, this, &Player::updateTimeDisplay);
-
-        // Connect item click event in the video list widget to update the video
-        connect(player_ui->listWidget, &QListWidget::itemPressed, this, &Player::onVideoItemClicked);
-
-
-        // Retrieve command-line arguments for loading video folder
-        QStringList arguments = QCoreApplication::arguments();
-
-        if (arguments.size() == 2) {
-            // If a folder path is provided as an argument, load the videos from that folder
-            QString folderPath = arguments[1];  // Get the first command-line argument (folder path)
-            loadVideosFromFolder(folderPath);    // Call the method to load videos
-        } else {
-            // If no folder path is provided, show an error message
-            const int result = QMessageBox::information(
-                NULL,
-                QString("Tomeo"),
-                QString("No videos found! Please add a command line argument with the folder location."));
-            exit(-1);  // Exit the program if no folder is specified
-        }
-    }
-
-    // Method to load videos from a specified folder
-    void loadVideosFromFolder(const QString &folderPath);
-
-    // Method to update the width of a child widget within a parent widget
-    void updateChildWidgetWidth(QWidget *parentWidget, QWidget *childWidget, double percentage);
-
-    // Private members of the Player class
-private:
-    Ui::MainWindow *player_ui;  // Pointer to the UI of the main window
-
-    TomeoUi uiTool;  // Custom UI helper object for updating UI elements
-
-    // Slot methods for handling button clicks
-    void on_playButton_clicked();        // Slot to handle play button click
-    void on_pauseButton_clicked();       // Slot to handle pause button click
-    void on_previousButton_clicked();    // Slot to handle previous button click
-    void on_nextButton_clicked();        // Slot to handle next button click
-    void adjustPlayPause();
-
-    // Method to animate a comment label (e.g., scrolling effect)
-    void animateComment(QLabel *commentLabel);
-
-    // Method to display a comment in the comment section
-    void displayComment(QLabel* commentLabel, const QString& commentText);
-
-    // Method to add a new comment with user info
-    void addComment(const QString &username, const QString &commentText, const QString &avatarPath, const QString &timestamp);
-
-    // Method to create a new comment widget from CommentData
-    QWidget* createCommentWidget(const CommentData &data);
-
-    // Initialize the comments section (e.g., set up layout, widgets, etc.)
-    void initComments();
-
-    void initData();
-
-    QMediaPlayer* player;           // Media player object for video playback
-    QMediaPlaylist* playerList;     // Playlist object to manage video list
-    QVideoWidget* videoWidget;      // Video widget for displaying video
-    QTimer* progressTimer;          // Timer for updating progress bar at regular intervals
-
-    int currentVideoIndex;          // Index of the currently playing video in the playlist
-    int maxValue = 10000;           // Maximum value for the progress slider
-    int previousVolume;             // Stores the previous volume for toggling mute/unmute
-    float currentPlaybackRate;      // Current playback speed (default is 1.0 for normal speed)
-
-public slots:
-    // Slot to handle the release of the progress slider
-    void onProgressSliderReleased();
-
-    // Slot to handle timer timeout event (used for updating progress)
-    void onTimerOut();
-
-    // Slot for fast-forward button action
-    void onFastForward();
-
-    // Slot for fast rewind button action
-    void onFastRewind();
-
-    // Slot to play the next video in the playlist
-    void playNextVideo();
-
-    // Slot to play the previous video in the playlist
-    void playPreviousVideo();
-
-    // Slot to toggle play/pause state
-    void togglePlayPause();
-
-    // Slot to set the video volume based on the slider value
-    void setVolume(int volume);
-
-    // Slot to update the time display on the UI
-    void updateTimeDisplay();
-
-    // Slot to handle item click event in the video list
-    void onVideoItemClicked(QListWidgetItem *item);
-
-    // Slot for handling progress slider click event
-    void onProgressSliderClicked();
-
-    // Slot for handling progress slider move event
-    void onProgressSliderMoved();
-
-    // Slot to handle media status change events (e.g., playing, paused, etc.)
-    void onMediaStatusChanged(QMediaPlayer::MediaStatus status);
-
-    // Slot to handle changes in the volume slider value
-    void onVolumeSliderChanged();
-
-    // Slot for volume button click event
-    void onVolumeButtonClicked();
-
-    // Slot to handle like button click event
-    void onLikeButtonCliked();
-
-    // Slot to handle star button click event
-    void onStarButtonCliked();
-
-    // Slot to handle share button click event
-    void onShareButtonClicked();
-
-    // Slot to handle send button click event (for comments)
-    void onSendButtonClicked();
-
-    // Slot to update the video title based on the selected video in the list
-    void updateVideoTitle();
-
-    // Slot to handle speed button click event (to change playback speed)
-    void onSpeedButtonClicked();
-
-    // Method to get the current time of the video (used for time display)
-    QString getCurrentTime();
-};
-
-
-#endif // PLAYER_H
+#ifndef PLAYER_H
+#define PLAYER_H
+
+#include "ui_mainwindow.h"
+#include "tomeo_ui.h"
+#include "mySlider.h"
+#include <QMediaPlayer>
+#include <QMediaPlaylist>
+#include <QVideoWidget>
+#include <QListView>
+#include "thumbnailLoader.h"
+#include "mediaLibrary.h"
+#include "mediaScanner.h"
+#include "mediaIndexer.h"
+#include "videoListModel.h"
+#include "videoItemDelegate.h"
+#include "thumbnailPrefetcher.h"
+#include "playerPool.h"
+#include "mediaPrefetcher.h"
+#include "seekScheduler.h"
+#include "scrubPreviewer.h"
+#include "danmakuOverlay.h"
+#include "commentFilter.h"
+#include "commentStore.h"
+#include "commentIngest.h"
+#include "commentListModel.h"
+#include "commentItemDelegate.h"
+#include <QTimer.h>
+#include <QMessageBox>
+#include <QVBoxLayout>
+#include <QGraphicsOpacityEffect>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QPair>
+#include <QSet>
+
+// Player class inherited from QMediaPlayer to manage video playback and related UI actions
+class Player : public QMediaPlayer {
+    Q_OBJECT
+
+public:
+    // Constructor initializes the player and sets up connections for UI elements
+    Player(Ui::MainWindow* ui, QWidget* parent)
+        :   QMediaPlayer(parent),
+        player_ui(ui),
+        uiTool(ui),
+        playerPool(new PlayerPool(ui->videoWidget, this)),
+        danmaku(new DanmakuOverlay(ui->videoWidget)),
+        seeker(new SeekScheduler(this)),
+        thumbnailLoader(new ThumbnailLoader(this)),
+        currentVideoIndex(0),
+        currentPlaybackRate(1.0)
+    {
+        initData();
+
+        // The pool stacks its video widgets in the video container; its first player is the one on screen
+        setActivePlayer(playerPool->current());
+
+        // Update UI styles using helper functions
+        uiTool.updateProgressBarStyle();  // Set the style for the progress bar
+        uiTool.updateVolumeBarStyle();    // Set the style for the volume slider
+        uiTool.setCommentAreaStyle(400);  // Set the style for the comment area
+        uiTool.setVideoLabelStyle();      // Set the style for the video label
+
+        uiTool.setButtonSize();           // Set the size of the buttons
+        uiTool.loadIcon();                // Load the necessary icons
+        uiTool.setButtonStyle();          // Apply styles to buttons
+
+        // Connect button click events to the corresponding slots
+        connect(player_ui->speedButton, &QPushButton::clicked, this, &Player::onSpeedButtonClicked);
+
+        // Connect fast forward button click event
+        connect(player_ui->fastForwardButton, &QPushButton::clicked, this, &Player::onFastForward);
+
+        // Connect fast rewind button click event
+        connect(player_ui->fastRewindButton, &QPushButton::clicked, this, &Player::onFastRewind);
+
+        // The video list is a model/view pair: rows are painted on demand by the delegate
+        videoModel = new VideoListModel(&library, this);
+        player_ui->listWidget->setModel(videoModel);
+        videoDelegate = new VideoItemDelegate(player_ui->listWidget);
+        player_ui->listWidget->setItemDelegate(videoDelegate);
+        player_ui->listWidget->setUniformItemSizes(true);  // Rows are never measured one by one
+        player_ui->listWidget->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+
+        // The comment panel is a model/view pair over the playing video's track; rows differ in height,
+        // so they are measured once each and laid out in batches to keep long tracks responsive
+        commentModel = new CommentListModel(&comments, this);
+        player_ui->commentList->setModel(commentModel);
+        player_ui->commentList->setItemDelegate(new CommentItemDelegate(player_ui->commentList));
+        player_ui->commentList->setLayoutMode(QListView::Batched);
+        player_ui->commentList->setResizeMode(QListView::Adjust);
+        player_ui->commentList->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+
+        // Thumbnails are only decoded for the rows on and around the screen
+        prefetcher = new ThumbnailPrefetcher(player_ui->listWidget, videoModel, &library, thumbnailLoader, this);
+        setThumbnailLevel(ThumbnailLoader::DesktopLevel);  // MainWindow picks the real layout once it knows its size
+
+        // Typing in the search box filters the list as you type
+        connect(player_ui->searchEdit, &QLineEdit::textChanged, videoModel, &VideoListModel::setFilterText);
+
+        // The sort selector lists the orders in the same sequence as MediaLibrary::SortOrder
+        connect(player_ui->sortBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int order) {
+            videoModel->setSortOrder(MediaLibrary::SortOrder(order));
+        });
+
+        // Filtering or sorting rebuilds the rows; the playing video stays selected if it is shown,
+        // and the videos next to it in the new order are opened in the background
+        connect(videoModel, &QAbstractItemModel::modelReset, this, [this]() {
+            if (playbackStarted) {
+                selectVideoRow(currentRemoved ? -1 : currentVideoIndex);
+                warmNeighbours();
+            }
+        });
+
+        // Connect list selection change to update video title
+        connect(player_ui->listWidget->selectionModel(), &QItemSelectionModel::selectionChanged,
+                this, &Player::updateVideoTitle);
+
+        // Connect other button events for like, star, share, and send actions
+        connect(player_ui->likeButton, &QPushButton::clicked, this, &Player::onLikeButtonCliked);
+        connect(player_ui->starButton, &QPushButton::clicked, this, &Player::onStarButtonCliked);
+        connect(player_ui->shareButton, &QPushButton::clicked, this, &Player::onShareButtonClicked);
+        connect(player_ui->sendButton, &QPushButton::clicked, this, &Player::onSendButtonClicked);
+
+        // Hide the comment section widgets initially
+        for (int i = 0; i < player_ui->commentLayout->count(); ++i) {
+            QWidget *widget = player_ui->commentLayout->itemAt(i)->widget();
+            if (widget) {
+                widget->hide();  // Hide comment widget
+            }
+            player_ui->closeCommentButton->hide();
+            player_ui->sayLabel->hide();
+        }
+
+        // Set the initial volume to 10% and update the volume slider
+        player->setVolume(10);  // Set initial volume level to 10%
+        player_ui->volumeSlider->setValue(10);
+
+        // Connect volume button to its respective slot
+        connect(player_ui->volumeButton, &QPushButton::clicked, this, &Player::onVolumeButtonClicked);
+
+        // Connect volume slider to change volume based on user interaction
+        connect(player_ui->volumeSlider, &MySlider::costomSliderClicked, this, &Player::onVolumeSliderChanged);
+        connect(player_ui->volumeSlider, &MySlider::sliderMoved, this, &Player::onVolumeSliderChanged);
+
+        // Set default state to pause for the play/pause button
+        // Connect the play/pause button to its respective slot
+        connect(player_ui->playPauseButton, &QPushButton::clicked, this, &Player::togglePlayPause);
+
+        // Connect next and previous buttons to their respective slots for video navigation
+        connect(player_ui->nextButton, &QPushButton::clicked, this, &Player::playNextVideo);
+        connect(player_ui->previousButton, &QPushButton::clicked, this, &Player::playPreviousVideo);
+
+        // Connect the progress slider to adjust the video position
+        connect(player_ui->progressSlider, &MySlider::costomSliderClicked, this, &Player::onProgressSliderClicked);
+        connect(player_ui->progressSlider, &MySlider::sliderMoved, this, &Player::onProgressSliderMoved);
+
+        // Connect slider released signal to update the video position once the slider is released
+        connect(player_ui->progressSlider, &MySlider::sliderReleased, this, &Player::onProgressSliderReleased);
+
+        // Set the range for the progress slider
+        player_ui->progressSlider->setRange(0, maxValue);
+
+        // The progress bar follows the player's position notifications; showing, hiding and
+        // resizing it changes how often those are wanted
+        player_ui->progressSlider->installEventFilter(this);
+
+        // Nothing follows the position while the window is hidden or minimized
+        player_ui->centralwidget->window()->installEventFilter(this);
+
+        // Hovering or dragging the progress bar shows the frame at that point from a sprite sheet
+        previewer = new ScrubPreviewer(this);
+        previewLabel = new QLabel(player_ui->centralwidget);
+        previewLabel->setStyleSheet("background-color: black; border: 2px solid white; border-radius: 4px;");
+        previewLabel->hide();
+        connect(player_ui->progressSlider, &MySlider::sliderHovered, this, &Player::showPreview);
+        connect(player_ui->progressSlider, &MySlider::hoverLeft, this, &Player::hidePreview);
+        connect(previewer, &ScrubPreviewer::sheetUpdated, this, [this]() {
+            if (previewValue >= 0) {
+                showPreview(previewValue);  // More frames have come in for what is being hovered
+            }
+        });
+
+        // Connect item click event in the video list to update the video
+        connect(player_ui->listWidget, &QListView::pressed, this, &Player::onVideoItemClicked);
+
+        // Thumbnails are decoded in the background and swapped into the list as they arrive
+        connect(thumbnailLoader, &ThumbnailLoader::thumbnailReady, this, &Player::onThumbnailReady);
+
+        // Watch the library folder and apply added, removed or renamed files as small diffs
+        folderWatcher = new QFileSystemWatcher(this);
+        rescanTimer = new QTimer(this);
+        rescanTimer->setSingleShot(true);
+        rescanTimer->setInterval(300);  // Let a burst of file operations settle first
+        connect(folderWatcher, &QFileSystemWatcher::directoryChanged, this, &Player::onFolderChanged);
+        connect(rescanTimer, &QTimer::timeout, this, &Player::applyFolderChanges);
+
+        // The folder is walked off the GUI thread and merged into the library batch by batch
+        scanner = new MediaScanner(this);
+        connect(scanner, &MediaScanner::batchFound, this, &Player::onScanBatch);
+        connect(scanner, &MediaScanner::finished, this, &Player::onScanFinished);
+
+        // Duration, frame size and codecs come from the catalogue, or are probed in the background
+        indexer = new MediaIndexer(this);
+        connect(indexer, &MediaIndexer::infoReady, this, &Player::onMediaInfo);
+
+        // The heads of the upcoming videos are read into the page cache ahead of time
+        readAhead = new MediaPrefetcher(this);
+        logCacheStats = qEnvironmentVariableIntValue("TOMEO_CACHE_STATS") > 0;
+
+        // Comments with a blocked word never reach the overlay or the comment panel
+        commentFilter = new CommentFilter(this);
+
+        // Comments are pinned to playback times and logged per video in the background
+        commentStore = new CommentStore(commentFilter, this);
+        connect(commentStore, &CommentStore::trackLoaded, this, &Player::onTrackLoaded);
+
+        // Live comments streamed in through a local socket arrive once per frame
+        ingest = new CommentIngest(commentFilter, this);
+        connect(ingest, &CommentIngest::messagesArrived, this, &Player::onLiveComments);
+
+        // Retrieve command-line arguments for loading video folder
+        QStringList arguments = QCoreApplication::arguments();
+
+        if (arguments.size() == 2) {
+            // If a folder path is provided as an argument, load the videos from that folder
+            QString folderPath = arguments[1];  // Get the first command-line argument (folder path)
+            loadVideosFromFolder(folderPath);    // Call the method to load videos
+        } else {
+            // If no folder path is provided, show an error message
+            const int result = QMessageBox::information(
+                NULL,
+                QString("Tomeo"),
+                QString("No videos found! Please add a command line argument with the folder location."));
+            exit(-1);  // Exit the program if no folder is specified
+        }
+    }
+
+    // Destructor: stops the comment threads while the filter they check still exists
+    ~Player();
+
+    // Method to load videos from a specified folder
+    void loadVideosFromFolder(const QString &folderPath);
+
+    // Method to select the list row of a library entry
+    void selectVideoRow(int index);
+
+    // Method to remove a library entry together with its playlist entry and list row
+    void removeVideoRow(int index);
+
+    // Library index of a video the running scan added with the same size and modification time
+    // as the one at the given index, i.e. what it was renamed to; -1 if there is none
+    int renamedTo(int index) const;
+
+    // Method to find the video a number of list rows away from the playing one
+    int neighbourVideo(int step) const;
+
+    // Method to make a player of the pool the one the controls and displays follow
+    void setActivePlayer(QMediaPlayer *active);
+
+    // Method to pre-open the videos next to the playing one and read the following ones ahead,
+    // so switching to them is instant
+    void warmNeighbours();
+
+    // Method to start the first video once the library has something in it
+    void startPlaybackIfIdle();
+
+    // Method to update the width of a child widget within a parent widget
+    void updateChildWidgetWidth(QWidget *parentWidget, QWidget *childWidget, double percentage);
+
+    // Switch the list thumbnails to the size used by a window layout
+    void setThumbnailLevel(ThumbnailLoader::Level level);
+
+    // Decode the thumbnails again if the window has moved to a screen of another pixel density
+    void onScreenChanged();
+
+    // Private members of the Player class
+private:
+    Ui::MainWindow *player_ui;  // Pointer to the UI of the main window
+
+    TomeoUi uiTool;  // Custom UI helper object for updating UI elements
+
+    // Slot methods for handling button clicks
+    void on_playButton_clicked();        // Slot to handle play button click
+    void on_pauseButton_clicked();       // Slot to handle pause button click
+    void on_previousButton_clicked();    // Slot to handle previous button click
+    void on_nextButton_clicked();        // Slot to handle next button click
+    void adjustPlayPause();
+
+    // Show the comments of the playing video: drop those of the previous one and read its track
+    void loadComments();
+
+    void initData();
+
+    PlayerPool* playerPool;         // The player on screen and the warm players for its neighbours
+    QMediaPlayer* player = nullptr; // The pool's player on screen, which the controls act on
+    DanmakuOverlay* danmaku;        // Flies comments across the video, above the pool's widgets
+    CommentFilter* commentFilter;   // Blocks comments containing a word from the word list
+    CommentStore* commentStore;     // Opens and appends to comment logs in the background
+    CommentIngest* ingest;          // Receives live comments from other programs
+    CommentTrack comments;          // Comments of the playing video, by playback time
+    CommentListModel* commentModel; // Presents the comments to the comment panel; changes to them go through it
+    QString commentVideo;           // Path of the video the comments belong to
+    int commentCursor = 0;          // First comment of the track not launched yet
+    qint64 commentPosition = 0;     // Playback position the comments were last launched up to
+    SeekScheduler* seeker;          // Coalesces the seeks of the progress slider and the skip buttons
+    ThumbnailLoader* thumbnailLoader; // Decodes list thumbnails on a worker pool
+    MediaLibrary library;           // The videos behind the player and the list widget
+    VideoListModel* videoModel;     // Presents the library to the video list view
+    VideoItemDelegate* videoDelegate; // Paints the rows of the video list
+    ThumbnailPrefetcher* prefetcher; // Requests thumbnails for the rows near the viewport
+    QFileSystemWatcher* folderWatcher; // Reports changes to the library folder
+    QTimer* rescanTimer;            // Coalesces bursts of folder changes into one rescan
+    MediaScanner* scanner;          // Walks the library folder on a background thread
+    MediaIndexer* indexer;          // Finds duration, frame size and codecs of every video
+    MediaPrefetcher* readAhead;     // Reads the start of the upcoming videos into the page cache
+    bool logCacheStats = false;     // Whether cache hit counts are logged on every switch; set by TOMEO_CACHE_STATS
+    QSet<QString> scanSeen;         // Videos the running scan has reported so far
+    QHash<QPair<qint64, qint64>, QString> scanAdded; // Videos the running scan added, by file size and modification time
+    bool currentRemoved = false;    // Whether the playing video has left the library; currentVideoIndex then
+                                    // names the video that took its row, which plays next
+    bool playbackStarted = false;   // Whether the first video of the folder has been started
+    bool progressShown = false;     // Whether the progress bar is on screen, minimized windows excluded
+    bool windowShown = false;       // Whether the window is on screen, neither hidden nor minimized
+    ScrubPreviewer* previewer;      // Extracts and caches the preview frames of the playing video
+    QLabel* previewLabel;           // Shows the preview frame above the progress bar
+    int previewValue = -1;          // Slider value the preview is shown for, or -1 while hidden
+
+    int currentVideoIndex;          // Library index of the currently playing video
+    int maxValue = 10000;           // Maximum value for the progress slider
+    int previousVolume;             // Stores the previous volume for toggling mute/unmute
+    float currentPlaybackRate;      // Current playback speed (default is 1.0 for normal speed)
+
+public slots:
+    // Slot to handle the release of the progress slider
+    void onProgressSliderReleased();
+
+    // Slot to move the progress bar to the current playback position
+    void updateProgress();
+
+    // Slot to ask the player for position notifications as often as the progress bar can show them
+    void updateNotifyInterval();
+
+    // Connect the time display, the progress bar and the comments to the position of the player on screen
+    void followPosition();
+
+    // Slot to have the preview frames of the playing video extracted or loaded
+    void requestPreviews();
+
+    // Slot to show the preview frame for a slider value above the progress bar
+    void showPreview(int value);
+
+    // Slot to hide the preview frame
+    void hidePreview();
+
+    // Slot to launch the comments due by the given playback position, or to skip past them after a seek
+    void syncComments(qint64 position);
+
+    // Slot to pin a frame's worth of live comments to the current position and fly them
+    void onLiveComments(const QVector<CommentIngest::Message> &messages);
+
+    // Slot to take over the track of a video once it has been read
+    void onTrackLoaded(const QString &videoPath, std::shared_ptr<CommentTrack> track);
+
+    // Slot for fast-forward button action
+    void onFastForward();
+
+    // Slot for fast rewind button action
+    void onFastRewind();
+
+    // Slot to play the next video in the playlist
+    void playNextVideo();
+
+    // Slot to play the previous video in the playlist
+    void playPreviousVideo();
+
+    // Slot to play the library entry at the given index
+    void playVideoAt(int index);
+
+    // Slot to toggle play/pause state
+    void togglePlayPause();
+
+    // Slot to set the video volume based on the slider value
+    void setVolume(int volume);
+
+    // Slot to update the time display on the UI
+    void updateTimeDisplay();
+
+    // Slot to swap a decoded thumbnail into the list row of the named video
+    void onThumbnailReady(const QString &fileName, const QImage &image);
+
+    // Slot to schedule a rescan after the library folder has changed
+    void onFolderChanged();
+
+    // Slot to rescan the folder so its differences with the library get applied
+    void applyFolderChanges();
+
+    // Slot to merge a batch of videos from the background scan into the library
+    void onScanBatch(const QString &folderPath, const std::vector<MediaLibrary::ScannedVideo> &videos);
+
+    // Slot to drop videos the finished scan no longer found
+    void onScanFinished(const QString &folderPath, bool folderFound);
+
+    // Slot to show the details the indexer found for a video
+    void onMediaInfo(const QString &path, const MediaLibrary::MediaInfo &info);
+
+    // Slot to handle item click event in the video list
+    void onVideoItemClicked(const QModelIndex &index);
+
+    // Slot for handling progress slider click event
+    void onProgressSliderClicked();
+
+    // Slot for handling progress slider move event
+    void onProgressSliderMoved();
+
+    // Slot to handle media status change events (e.g., playing, paused, etc.)
+    void onMediaStatusChanged(QMediaPlayer::MediaStatus status);
+
+    // Slot to handle changes in the volume slider value
+    void onVolumeSliderChanged();
+
+    // Slot for volume button click event
+    void onVolumeButtonClicked();
+
+    // Slot to handle like button click event
+    void onLikeButtonCliked();
+
+    // Slot to handle star button click event
+    void onStarButtonCliked();
+
+    // Slot to handle share button click event
+    void onShareButtonClicked();
+
+    // Slot to handle send button click event (for comments)
+    void onSendButtonClicked();
+
+    // Slot to update the video title based on the selected video in the list
+    void updateVideoTitle();
+
+    // Slot to handle speed button click event (to change playback speed)
+    void onSpeedButtonClicked();
+
+protected:
+    // Notices the progress bar being shown, hidden or resized, and the window being hidden or minimized
+    bool eventFilter(QObject *watched, QEvent *event) override;
+};
+
+
+#endif // PLAYER_H
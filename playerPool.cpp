@@ -0,0 +1,190 @@
+#include "playerPool.h"
+#include <QStackedLayout>
+#include <QVideoWidget>
+#include <QWidget>
+
+namespace {
+
+const int maxWarmPlayers = 3;                     // Neighbours kept open besides the video on screen
+const qint64 defaultBudget = 256 * 1024 * 1024;   // Enough for three warm 1080p players
+const int queuedFrames = 8;                       // Decoded frames a player typically holds on to
+const QSize assumedResolution(1920, 1080);        // Used while a video's frame size is unknown
+
+}
+
+PlayerPool::PlayerPool(QWidget *container, QObject *parent)
+    : QObject(parent),
+    container(container),
+    budget(defaultBudget)
+{
+    // Every video widget covers the whole container; the one on screen is simply the topmost
+    layout = new QStackedLayout(container);
+    layout->setStackingMode(QStackedLayout::StackAll);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    int budgetMb = qEnvironmentVariableIntValue("TOMEO_PLAYER_POOL_MB");
+    if (budgetMb > 0) {
+        setMemoryBudget(qint64(budgetMb) * 1024 * 1024);
+    }
+
+    active = spare();
+}
+
+QMediaPlayer *PlayerPool::activate(const Video &video)
+{
+    if (active->url == video.url) {
+        return active->player;
+    }
+
+    Entry *next = find(video.url);
+    if (next) {
+        hits++;
+    } else {
+        misses++;
+        next = spare();
+        if (!next) {
+            // Every player is busy; give up the warm one that is least likely to be wanted
+            next = entries.back().get() != active ? entries.back().get() : entries.front().get();
+        }
+        preload(next, video);
+    }
+
+    // Only the player on screen is heard, and it plays like the one before it did
+    QMediaPlayer *previous = active->player;
+    next->player->setVolume(previous->volume());
+    next->player->setPlaybackRate(previous->playbackRate());
+    next->player->setMuted(false);
+
+    // The previous video is the most likely one to come back to, so it stays open
+    previous->pause();
+    previous->setMuted(true);
+    previous->setPosition(0);
+
+    // The new widget goes on top of every other video widget, warm ones preloaded since included,
+    // and whatever else lives in the container, like the comments flying over the video, above it
+    active->widget->lower();
+    active = next;
+    active->widget->raise();
+    for (QWidget *child : container->findChildren<QWidget *>(QString(), Qt::FindDirectChildrenOnly)) {
+        if (!owns(child)) {
+            child->raise();
+        }
+    }
+    return active->player;
+}
+
+void PlayerPool::warm(const QList<Video> &videos)
+{
+    // Pick the videos to keep open, most likely first, until the budget is used up
+    qint64 used = active->cost;
+    QList<Video> wanted;
+    for (const Video &video : videos) {
+        if (wanted.size() == maxWarmPlayers) {
+            break;
+        }
+        bool duplicate = video.url == active->url;
+        for (const Video &other : wanted) {
+            duplicate = duplicate || other.url == video.url;
+        }
+        qint64 cost = decoderCost(video.resolution);
+        if (duplicate || used + cost > budget) {
+            continue;
+        }
+        used += cost;
+        wanted.append(video);
+    }
+
+    // Release the players nobody is going to switch to, then open what is missing
+    for (const std::unique_ptr<Entry> &entry : entries) {
+        if (entry.get() == active || entry->url.isEmpty()) {
+            continue;
+        }
+        bool keep = false;
+        for (const Video &video : wanted) {
+            keep = keep || video.url == entry->url;
+        }
+        if (!keep) {
+            release(entry.get());
+        }
+    }
+    for (const Video &video : wanted) {
+        if (!find(video.url)) {
+            Entry *entry = spare();
+            if (entry) {
+                preload(entry, video);
+            }
+        }
+    }
+}
+
+void PlayerPool::clear()
+{
+    for (const std::unique_ptr<Entry> &entry : entries) {
+        release(entry.get());
+    }
+}
+
+PlayerPool::Entry *PlayerPool::find(const QUrl &url) const
+{
+    for (const std::unique_ptr<Entry> &entry : entries) {
+        if (entry.get() != active && entry->url == url) {
+            return entry.get();
+        }
+    }
+    return nullptr;
+}
+
+bool PlayerPool::owns(const QWidget *widget) const
+{
+    for (const std::unique_ptr<Entry> &entry : entries) {
+        if (entry->widget == widget) {
+            return true;
+        }
+    }
+    return false;
+}
+
+PlayerPool::Entry *PlayerPool::spare()
+{
+    for (const std::unique_ptr<Entry> &entry : entries) {
+        if (entry.get() != active && entry->url.isEmpty()) {
+            return entry.get();
+        }
+    }
+    if (int(entries.size()) > maxWarmPlayers) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Entry> entry(new Entry);
+    entry->player = new QMediaPlayer(this);
+    entry->widget = new QVideoWidget(container);
+    layout->addWidget(entry->widget);
+    entry->widget->lower();  // Below the video on screen until it is switched to
+    entry->player->setVideoOutput(entry->widget);
+    entries.push_back(std::move(entry));
+    return entries.back().get();
+}
+
+void PlayerPool::preload(Entry *entry, const Video &video)
+{
+    entry->url = video.url;
+    entry->cost = decoderCost(video.resolution);
+
+    // Pausing a freshly set media opens the file and decodes the first frame, without a sound
+    entry->player->setMuted(true);
+    entry->player->setMedia(video.url);
+    entry->player->pause();
+}
+
+void PlayerPool::release(Entry *entry)
+{
+    entry->url.clear();
+    entry->cost = 0;
+    entry->player->setMedia(QMediaContent());
+}
+
+qint64 PlayerPool::decoderCost(const QSize &resolution)
+{
+    QSize frame = resolution.isValid() ? resolution : assumedResolution;
+    return qint64(frame.width()) * frame.height() * 4 * queuedFrames;
+}
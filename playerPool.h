@@ -0,0 +1,93 @@
+#ifndef PLAYERPOOL_H
+#define PLAYERPOOL_H
+
+#include <QList>
+#include <QMediaPlayer>
+#include <QObject>
+#include <QSize>
+#include <QUrl>
+#include <memory>
+#include <vector>
+
+class QStackedLayout;
+class QVideoWidget;
+class QWidget;
+
+// PlayerPool keeps the player on screen together with a few pre-opened players for
+// the videos the user is most likely to switch to next. Every player renders into its
+// own QVideoWidget, all stacked in the same container. A warm player has opened its
+// file and decoded its first frame while paused and muted underneath the one on screen,
+// so switching to it only reorders the stack. Warm players are kept while the decoder
+// memory they are estimated to hold fits the budget.
+class PlayerPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    // A video worth keeping warm
+    struct Video {
+        QUrl url;         // File to open
+        QSize resolution; // Frame size, used to estimate decoder memory; invalid while unknown
+    };
+
+    // Constructor: the video widgets fill the given container
+    PlayerPool(QWidget *container, QObject *parent = nullptr);
+
+    // The player whose video is on screen; there always is one
+    QMediaPlayer *current() const { return active->player; }
+
+    // Bring the given video on screen and return its player, opening it if no warm player has it.
+    // Volume and playback rate carry over; the previous player stays warm, paused at its start.
+    QMediaPlayer *activate(const Video &video);
+
+    // Keep the given videos warm, most likely first, as far as the budget allows; other warm players are released
+    void warm(const QList<Video> &videos);
+
+    // Release every warm player and stop the one on screen
+    void clear();
+
+    // Decoder memory the players may hold together, the one on screen included.
+    // Defaults to TOMEO_PLAYER_POOL_MB when set.
+    void setMemoryBudget(qint64 bytes) { budget = bytes; }
+
+    // Switches served by a warm player, and those that had to open the file first
+    int hitCount() const { return hits; }
+    int missCount() const { return misses; }
+
+private:
+    // One player and the widget it renders into
+    struct Entry {
+        QMediaPlayer *player;  // Child of the pool
+        QVideoWidget *widget;  // Owned by the container
+        QUrl url;              // Video loaded into the player; empty while idle
+        qint64 cost = 0;       // Estimated decoder memory of that video
+    };
+
+    // The entry holding the given video, or nullptr
+    Entry *find(const QUrl &url) const;
+
+    // Whether the widget is one of the players' video widgets
+    bool owns(const QWidget *widget) const;
+
+    // An idle entry, created when there is none and the pool is not full; nullptr otherwise
+    Entry *spare();
+
+    // Open a video in an entry that is not on screen: muted, paused on its first frame
+    void preload(Entry *entry, const Video &video);
+
+    // Unload an entry so it holds no decoder
+    void release(Entry *entry);
+
+    // Rough decoder memory of a video: a queue of decoded frames at its resolution
+    static qint64 decoderCost(const QSize &resolution);
+
+    QWidget *container;                          // Widget the video widgets are stacked in
+    QStackedLayout *layout;                      // Keeps every video widget the size of the container
+    std::vector<std::unique_ptr<Entry>> entries; // Every player, on screen, warm or idle
+    Entry *active = nullptr;                     // The entry on screen
+    qint64 budget;                               // Decoder memory the players may hold together
+    int hits = 0;                                // Switches to a warm player
+    int misses = 0;                              // Switches that opened the file first
+};
+
+#endif // PLAYERPOOL_H
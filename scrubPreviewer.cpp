@@ -0,0 +1,336 @@
+#include "scrubPreviewer.h"
+#include <QAbstractVideoSurface>
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMediaPlayer>
+#include <QPainter>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QVideoFrame>
+
+namespace {
+
+const quint32 fileMagic = 0x544f4d50;       // "TOMP"
+const quint32 fileVersion = 1;              // Layout of the sheet files
+const QSize tileBox(160, 90);               // Frames are scaled to fit this box
+const int sheetColumns = 10;                // Tiles per row of the sheet
+const int maxFrames = 100;                  // Frames per video at most
+const qint64 minIntervalMs = 1000;          // Short videos get a frame per second
+const int frameTimeoutMs = 2000;            // Longest wait for the offscreen player to show a frame
+const int memoryBudgetKb = 32 * 1024;       // Complete sheets kept in memory
+
+}
+
+QImage ScrubPreviewer::Sheet::frameAt(qint64 position) const
+{
+    if (interval <= 0 || count == 0) {
+        return QImage();
+    }
+    int frame = int(qBound<qint64>(0, position / interval, total - 1));
+    if (frame >= count) {
+        return QImage();
+    }
+    return image.copy(QRect(QPoint(frame % sheetColumns * tile.width(), frame / sheetColumns * tile.height()), tile));
+}
+
+// Video surface of the offscreen player: hands every frame it is shown to the previewer as a QImage
+class FrameGrabber : public QAbstractVideoSurface
+{
+public:
+    explicit FrameGrabber(ScrubPreviewer *previewer)
+        : QAbstractVideoSurface(previewer), previewer(previewer) {}
+
+    QList<QVideoFrame::PixelFormat> supportedPixelFormats(QAbstractVideoBuffer::HandleType type) const override
+    {
+        // Only frames in main memory, in formats QImage can wrap; the backend converts everything else
+        if (type != QAbstractVideoBuffer::NoHandle) {
+            return {};
+        }
+        return {QVideoFrame::Format_RGB32, QVideoFrame::Format_ARGB32, QVideoFrame::Format_ARGB32_Premultiplied,
+                QVideoFrame::Format_RGB24};
+    }
+
+    bool present(const QVideoFrame &frame) override
+    {
+        QVideoFrame copy(frame);
+        QImage::Format format = QVideoFrame::imageFormatFromPixelFormat(copy.pixelFormat());
+        if (format == QImage::Format_Invalid || !copy.map(QAbstractVideoBuffer::ReadOnly)) {
+            return true;  // Not one of ours; the tile stays blank
+        }
+
+        // This runs on the GUI thread, so the full frame is only sampled, down to twice the tile size;
+        // the smooth pass then works on that small image, whatever the video's resolution
+        QImage image(copy.bits(), copy.width(), copy.height(), copy.bytesPerLine(), format);
+        QImage sampled = image.size().width() > 2 * tileBox.width() || image.size().height() > 2 * tileBox.height()
+                         ? image.scaled(tileBox * 2, Qt::KeepAspectRatio, Qt::FastTransformation)
+                         : image.copy();
+        copy.unmap();
+        QImage scaled = sampled.scaled(tileBox, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+        qint64 time = frame.startTime() >= 0 ? frame.startTime() / 1000 : -1;
+        previewer->frameGrabbed(scaled, time);
+        return true;
+    }
+
+private:
+    ScrubPreviewer *previewer;  // Previewer that packs the frames
+};
+
+// Reads the cached sheet of one video; runs on the previewer's disk thread
+class SheetLoadTask : public QRunnable
+{
+public:
+    SheetLoadTask(ScrubPreviewer *previewer, const ScrubPreviewer::Job &job)
+        : previewer(previewer), job(job) {}
+
+    void run() override
+    {
+        ScrubPreviewer::Sheet sheet;
+        QFile file(ScrubPreviewer::sheetFilePath(job.path));
+        if (file.open(QIODevice::ReadOnly)) {
+            QDataStream in(&file);
+            in.setVersion(QDataStream::Qt_5_11);
+            quint32 magic = 0;
+            quint32 version = 0;
+            qint64 fileSize = -1;
+            qint64 modified = -1;
+            qint32 total = 0;
+            QByteArray encoded;
+            in >> magic >> version >> fileSize >> modified >> sheet.interval >> total >> sheet.tile >> encoded;
+
+            // A sheet for an older version of the file is as good as none
+            if (in.status() == QDataStream::Ok && magic == fileMagic && version == fileVersion
+                    && fileSize == job.fileSize && modified == job.modified) {
+                sheet.image = QImage::fromData(encoded, "JPG");
+                sheet.total = total;
+                sheet.count = total;
+                sheet.fileSize = fileSize;
+                sheet.modified = modified;
+            }
+        }
+
+        ScrubPreviewer *target = previewer;
+        ScrubPreviewer::Job done = job;
+        QMetaObject::invokeMethod(previewer, [target, done, sheet]() {
+            target->loaded(done, sheet);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    ScrubPreviewer *previewer;     // Previewer that receives the sheet
+    ScrubPreviewer::Job job;       // Video whose sheet to read
+};
+
+// Writes a finished sheet to the disk cache; runs on the previewer's disk thread
+class SheetSaveTask : public QRunnable
+{
+public:
+    SheetSaveTask(const ScrubPreviewer::Job &job, const ScrubPreviewer::Sheet &sheet)
+        : job(job), sheet(sheet) {}
+
+    void run() override
+    {
+        // Frames this small compress well as a JPEG, so a sheet costs tens of kilobytes on disk
+        QByteArray encoded;
+        QBuffer buffer(&encoded);
+        buffer.open(QIODevice::WriteOnly);
+        if (!sheet.image.save(&buffer, "JPG", 80)) {
+            return;
+        }
+
+        QString filePath = ScrubPreviewer::sheetFilePath(job.path);
+        QDir().mkpath(QFileInfo(filePath).absolutePath());
+        QSaveFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return;
+        }
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_5_11);
+        out << fileMagic << fileVersion << job.fileSize << job.modified << sheet.interval << qint32(sheet.total)
+            << sheet.tile << encoded;
+        file.commit();
+    }
+
+private:
+    ScrubPreviewer::Job job;       // Video the sheet belongs to
+    ScrubPreviewer::Sheet sheet;   // The finished sheet
+};
+
+ScrubPreviewer::ScrubPreviewer(QObject *parent)
+    : QObject(parent)
+{
+    pool.setMaxThreadCount(1);  // Sheets are small; one thread keeps the disk access in order
+    sheets.setMaxCost(memoryBudgetKb);
+
+    frameTimeout.setSingleShot(true);
+    frameTimeout.setInterval(frameTimeoutMs);
+    connect(&frameTimeout, &QTimer::timeout, this, &ScrubPreviewer::skipFrame);
+}
+
+ScrubPreviewer::~ScrubPreviewer()
+{
+    abandonExtraction();
+    pool.waitForDone();  // Running loads still reference this previewer
+}
+
+void ScrubPreviewer::request(const QString &path, qint64 fileSize, qint64 modified, qint64 duration)
+{
+    if (duration <= 0) {
+        return;  // Frame times cannot be laid out yet
+    }
+    if (path == job.path && fileSize == job.fileSize && modified == job.modified && (loading || extracting)) {
+        return;  // Already on its way
+    }
+    if (extracting) {
+        abandonExtraction();  // Only the playing video's sheet is worth the decoding
+    }
+
+    job = Job{path, fileSize, modified, duration};
+    const Sheet *cached = sheets.object(path);
+    if (cached && cached->fileSize == fileSize && cached->modified == modified) {
+        emit sheetUpdated(path);
+        return;
+    }
+    sheets.remove(path);  // Taken from the video before it was rewritten, if at all
+    loading = true;
+    pool.start(new SheetLoadTask(this, job));
+}
+
+const ScrubPreviewer::Sheet *ScrubPreviewer::sheet(const QString &path) const
+{
+    if (extracting && path == job.path) {
+        return &building;
+    }
+    return sheets.object(path);
+}
+
+void ScrubPreviewer::loaded(const Job &loadedJob, const Sheet &cached)
+{
+    if (loadedJob.path != job.path || loadedJob.fileSize != job.fileSize || loadedJob.modified != job.modified) {
+        return;  // Another video has been requested since
+    }
+    loading = false;
+
+    if (cached.image.isNull()) {
+        startExtraction();
+        return;
+    }
+    sheets.insert(job.path, new Sheet(cached), qMax(1, int(cached.image.sizeInBytes() / 1024)));
+    emit sheetUpdated(job.path);
+}
+
+void ScrubPreviewer::startExtraction()
+{
+    if (!extractor) {
+        // A player of its own, rendering into memory only and never heard
+        extractor = new QMediaPlayer(this, QMediaPlayer::VideoSurface);
+        grabber = new FrameGrabber(this);
+        extractor->setVideoOutput(grabber);
+        extractor->setMuted(true);
+        connect(extractor, &QMediaPlayer::mediaStatusChanged, this, [this](QMediaPlayer::MediaStatus status) {
+            if (!extracting) {
+                return;
+            }
+            if ((status == QMediaPlayer::LoadedMedia || status == QMediaPlayer::BufferedMedia) && target < 0) {
+                grabNext();  // Opened; start with the first frame
+            } else if (status == QMediaPlayer::InvalidMedia) {
+                abandonExtraction();
+            }
+        });
+    }
+
+    // One frame per interval, at most maxFrames of them, each taken from the middle of its interval
+    building = Sheet();
+    building.total = int(qBound<qint64>(1, job.duration / minIntervalMs, maxFrames));
+    building.interval = qMax<qint64>(1, job.duration / building.total);
+    building.tile = tileBox;
+    building.fileSize = job.fileSize;
+    building.modified = job.modified;
+    int rows = (building.total + sheetColumns - 1) / sheetColumns;
+    building.image = QImage(sheetColumns * tileBox.width(), rows * tileBox.height(), QImage::Format_RGB888);
+    building.image.fill(Qt::black);
+
+    extracting = true;
+    target = -1;
+    extractor->setMedia(QUrl::fromLocalFile(job.path));
+    extractor->pause();  // Loads the file without playing it
+}
+
+void ScrubPreviewer::abandonExtraction()
+{
+    if (!extracting) {
+        return;
+    }
+    extracting = false;
+    target = -1;
+    frameTimeout.stop();
+    building = Sheet();
+    extractor->setMedia(QMediaContent());
+}
+
+void ScrubPreviewer::grabNext()
+{
+    if (building.count == building.total) {
+        finishExtraction();
+        return;
+    }
+    target = building.count * building.interval + building.interval / 2;
+    frameTimeout.start();
+    extractor->setPosition(target);
+}
+
+void ScrubPreviewer::frameGrabbed(const QImage &frame, qint64 time)
+{
+    if (!extracting || target < 0) {
+        return;  // Prerolled before the first seek
+    }
+    if (time >= 0 && qAbs(time - target) > building.interval) {
+        return;  // A frame from before the seek landed
+    }
+    frameTimeout.stop();
+
+    // Centre the frame in its tile; letterboxed frames keep black bars
+    QRect tile(QPoint(building.count % sheetColumns * tileBox.width(), building.count / sheetColumns * tileBox.height()), tileBox);
+    QPainter painter(&building.image);
+    painter.drawImage(tile.x() + (tileBox.width() - frame.width()) / 2, tile.y() + (tileBox.height() - frame.height()) / 2, frame);
+    painter.end();
+
+    building.count++;
+    emit sheetUpdated(job.path);
+    grabNext();
+}
+
+void ScrubPreviewer::skipFrame()
+{
+    if (!extracting) {
+        return;
+    }
+    building.count++;
+    grabNext();
+}
+
+void ScrubPreviewer::finishExtraction()
+{
+    extracting = false;
+    target = -1;
+    frameTimeout.stop();
+    extractor->setMedia(QMediaContent());
+
+    sheets.insert(job.path, new Sheet(building), qMax(1, int(building.image.sizeInBytes() / 1024)));
+    pool.start(new SheetSaveTask(job, building));
+    building = Sheet();
+    emit sheetUpdated(job.path);
+}
+
+QString ScrubPreviewer::sheetFilePath(const QString &path)
+{
+    // Paths can be long and hold any character, so the file is named after a hash of the path
+    QByteArray hash = QCryptographicHash::hash(path.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/previews/" + QString::fromLatin1(hash) + ".sheet";
+}
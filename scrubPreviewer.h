@@ -0,0 +1,106 @@
+#ifndef SCRUBPREVIEWER_H
+#define SCRUBPREVIEWER_H
+
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+
+class QMediaPlayer;
+class FrameGrabber;
+
+// ScrubPreviewer provides the small frames the progress bar shows while it is hovered
+// or dragged. For the playing video it extracts a frame at regular intervals with an
+// offscreen, muted player and packs them into one sprite sheet, tile by tile, so the
+// preview never touches the decoder of the video on screen. Finished sheets are kept
+// in memory for the last few videos and written to a disk cache, keyed by the video's
+// path, size and modification time, so a video is only ever extracted once.
+class ScrubPreviewer : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Frames of one video at regular intervals, packed row by row into one image
+    struct Sheet {
+        QImage image;         // Every frame, sheetColumns tiles to a row
+        QSize tile;           // Size of one frame in the image
+        qint64 interval = 0;  // Playback time covered by one frame, in milliseconds
+        int total = 0;        // Frames the sheet holds once it is complete
+        int count = 0;        // Frames extracted so far; they are extracted in order
+        qint64 fileSize = -1; // Size of the video file the frames were taken from
+        qint64 modified = -1; // Modification time of that file (ms since epoch)
+
+        // The frame for the given playback position, or a null image while it has not been extracted
+        QImage frameAt(qint64 position) const;
+    };
+
+    // Constructor: opens nothing until the first request
+    explicit ScrubPreviewer(QObject *parent = nullptr);
+
+    // Destructor: abandons the running extraction and waits for disk cache work
+    ~ScrubPreviewer();
+
+    // Make the sheet of a video available: from memory, from the disk cache, or by extracting it in the background.
+    // The size and modification time decide whether a cached sheet is current. Extraction of any other video is abandoned.
+    void request(const QString &path, qint64 fileSize, qint64 modified, qint64 duration);
+
+    // The sheet of the video at the given path, possibly still being filled; nullptr if there is none yet
+    const Sheet *sheet(const QString &path) const;
+
+signals:
+    // Emitted when frames have been added to the sheet of a video, or it has come in from the disk cache
+    void sheetUpdated(const QString &path);
+
+private:
+    friend class FrameGrabber;
+    friend class SheetLoadTask;
+    friend class SheetSaveTask;
+
+    // The video whose sheet is wanted
+    struct Job {
+        QString path;
+        qint64 fileSize = -1;
+        qint64 modified = -1;
+        qint64 duration = 0;
+    };
+
+    // Called on the GUI thread with a sheet from the disk cache; its image is null on a miss
+    void loaded(const Job &loadedJob, const Sheet &cached);
+
+    // Open the video in the offscreen player and lay out an empty sheet
+    void startExtraction();
+
+    // Stop the offscreen player and drop the sheet being built
+    void abandonExtraction();
+
+    // Seek the offscreen player to the next frame time, or finish the sheet
+    void grabNext();
+
+    // Called by the grabber with a frame the offscreen player has shown at the given time (-1 if unknown)
+    void frameGrabbed(const QImage &frame, qint64 time);
+
+    // Leave the tile of a frame that never came blank and carry on with the next one
+    void skipFrame();
+
+    // Keep a complete sheet in memory and write it to the disk cache
+    void finishExtraction();
+
+    // Disk cache file of the sheet of a video
+    static QString sheetFilePath(const QString &path);
+
+    QThreadPool pool;                     // Reads and writes the disk cache
+    mutable QCache<QString, Sheet> sheets; // Complete sheets by video path; cost in KB
+    Job job;                              // Video whose sheet was last requested
+    bool loading = false;                 // Whether the disk cache is being read for that video
+    QMediaPlayer *extractor = nullptr;    // Offscreen player used for extraction, created on first use
+    FrameGrabber *grabber = nullptr;      // Video surface the offscreen player renders into
+    bool extracting = false;              // Whether the sheet of the job is being extracted
+    Sheet building;                       // Sheet being filled by the extraction
+    qint64 target = -1;                   // Playback time of the frame being waited for, or -1
+    QTimer frameTimeout;                  // Gives up on a frame the player does not deliver
+};
+
+#endif // SCRUBPREVIEWER_H
@@ -0,0 +1,198 @@
+#include "searchIndex.h"
+#include <algorithm>
+
+namespace {
+
+const int compactThreshold = 256 * 1024;  // Dead characters tolerated in the text pool before it is rewritten
+
+}
+
+void SearchIndex::clear()
+{
+    texts.clear();
+    spans.clear();
+    deadChars = 0;
+    postings.clear();
+    lastQuery.clear();
+    lastWords.clear();
+    lastResults.clear();
+}
+
+void SearchIndex::insert(quint32 id, const QString &text)
+{
+    QString folded = text.toCaseFolded();
+    if (id >= spans.size()) {
+        spans.resize(id + 1, TextSpan{0, 0});
+    }
+    deadChars += int(spans[id].length);
+    spans[id] = TextSpan{quint32(texts.size()), quint32(folded.size())};
+    texts += folded;
+
+    // Every distinct trigram once
+    std::vector<quint64> keys;
+    keys.reserve(folded.size());
+    for (int i = 0; i + 3 <= folded.size(); ++i) {
+        keys.push_back(trigram(folded.constData() + i));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    // Ids are handed out in ascending order, so new videos are appended; only re-indexed ones are slotted in
+    for (quint64 key : keys) {
+        std::vector<quint32> &list = postings[key];
+        if (list.empty() || list.back() < id) {
+            list.push_back(id);
+        } else {
+            auto position = std::lower_bound(list.begin(), list.end(), id);
+            if (*position != id) {
+                list.insert(position, id);
+            }
+        }
+    }
+
+    // Keep the previous answer current, so the next keystroke can still refine it
+    if (!lastQuery.isEmpty()) {
+        auto position = std::lower_bound(lastResults.begin(), lastResults.end(), id);
+        bool listed = position != lastResults.end() && *position == id;
+        bool matching = containsAll(id, lastWords);
+        if (matching && !listed) {
+            lastResults.insert(position, id);
+        } else if (!matching && listed) {
+            lastResults.erase(position);
+        }
+    }
+}
+
+void SearchIndex::remove(quint32 id)
+{
+    if (id >= spans.size() || spans[id].length == 0) {
+        return;
+    }
+    deadChars += int(spans[id].length);
+    spans[id].length = 0;
+
+    auto position = std::lower_bound(lastResults.begin(), lastResults.end(), id);
+    if (position != lastResults.end() && *position == id) {
+        lastResults.erase(position);
+    }
+
+    // Removed text only wastes memory, so rewrite the pool once it makes up most of it
+    if (deadChars > compactThreshold && deadChars > texts.size() / 2) {
+        compact();
+    }
+}
+
+std::vector<quint32> SearchIndex::search(const QString &query)
+{
+    QStringList queryWords = words(query);
+    if (queryWords.isEmpty()) {
+        lastQuery.clear();
+        lastWords.clear();
+        lastResults.clear();
+        return {};
+    }
+    QString joined = queryWords.join(QLatin1Char(' '));
+
+    // Typing on only narrows the previous results, so they are a candidate list of their own
+    std::vector<quint32> previous;
+    const std::vector<quint32> *candidates = nullptr;
+    if (!lastQuery.isEmpty() && joined.startsWith(lastQuery)) {
+        previous.swap(lastResults);
+        candidates = &previous;
+    }
+
+    // Every match is on the list of every trigram of every word, so the shortest list is enough to check
+    bool impossible = false;
+    for (const QString &word : queryWords) {
+        for (int i = 0; i + 3 <= word.size() && !impossible; ++i) {
+            auto list = postings.constFind(trigram(word.constData() + i));
+            if (list == postings.constEnd()) {
+                impossible = true;  // No video has ever contained this trigram
+            } else if (!candidates || list->size() < candidates->size()) {
+                candidates = &list.value();
+            }
+        }
+    }
+
+    std::vector<quint32> results;
+    if (impossible) {
+        // Nothing matches
+    } else if (candidates) {
+        for (quint32 id : *candidates) {
+            if (containsAll(id, queryWords)) {
+                results.push_back(id);
+            }
+        }
+    } else {
+        // Only words too short for a trigram; check every video
+        for (quint32 id = 0; id < spans.size(); ++id) {
+            if (containsAll(id, queryWords)) {
+                results.push_back(id);
+            }
+        }
+    }
+
+    lastQuery = joined;
+    lastWords = queryWords;
+    lastResults = results;
+    return results;
+}
+
+bool SearchIndex::matches(quint32 id, const QString &query) const
+{
+    return containsAll(id, words(query));
+}
+
+QStringList SearchIndex::words(const QString &query)
+{
+    QString folded = query.toCaseFolded().simplified();
+    return folded.isEmpty() ? QStringList() : folded.split(QLatin1Char(' '));
+}
+
+quint64 SearchIndex::trigram(const QChar *chars)
+{
+    return (quint64(chars[0].unicode()) << 32) | (quint64(chars[1].unicode()) << 16) | chars[2].unicode();
+}
+
+bool SearchIndex::containsAll(quint32 id, const QStringList &queryWords) const
+{
+    if (id >= spans.size() || spans[id].length == 0) {
+        return false;
+    }
+
+    QStringRef text(&texts, int(spans[id].offset), int(spans[id].length));
+    for (const QString &word : queryWords) {
+        if (!text.contains(word)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SearchIndex::compact()
+{
+    QString pool;
+    pool.reserve(texts.size() - deadChars);
+    for (TextSpan &span : spans) {
+        if (span.length == 0) {
+            span.offset = 0;
+            continue;
+        }
+        quint32 offset = quint32(pool.size());
+        pool.append(texts.constData() + span.offset, int(span.length));
+        span.offset = offset;
+    }
+    texts = pool;
+    deadChars = 0;
+
+    // Removed videos leave the trigram lists too
+    for (auto list = postings.begin(); list != postings.end();) {
+        std::vector<quint32> &ids = list.value();
+        ids.erase(std::remove_if(ids.begin(), ids.end(), [this](quint32 id) { return spans[id].length == 0; }), ids.end());
+        if (ids.empty()) {
+            list = postings.erase(list);
+        } else {
+            ++list;
+        }
+    }
+}
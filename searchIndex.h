@@ -0,0 +1,63 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QStringRef>
+#include <vector>
+
+// SearchIndex answers as-you-type searches over the library. The searchable text of
+// every video (its file name and indexed details, case-folded) is split into trigrams,
+// each with an ascending list of the videos that contain it. A query only checks the
+// videos on its rarest trigram's list against the full text, and a query that merely
+// extends the previous one only checks the previous results. Videos are identified
+// by their MediaLibrary id, so the index survives inserts and removals.
+class SearchIndex
+{
+public:
+    // Forget every video
+    void clear();
+
+    // Index the searchable text of a video, replacing what was indexed for it before
+    void insert(quint32 id, const QString &text);
+
+    // Forget a video
+    void remove(quint32 id);
+
+    // Ids of the videos containing every word of the query, in ascending order.
+    // An empty query returns nothing; callers show the whole library instead.
+    std::vector<quint32> search(const QString &query);
+
+    // Whether a video contains every word of the query
+    bool matches(quint32 id, const QString &query) const;
+
+private:
+    // Where one video's text lives in the text pool
+    struct TextSpan {
+        quint32 offset;  // First character in the pool
+        quint32 length;  // Number of characters; 0 for removed videos
+    };
+
+    // The case-folded words of a query
+    static QStringList words(const QString &query);
+
+    // Three consecutive characters packed into one key
+    static quint64 trigram(const QChar *chars);
+
+    // Whether the indexed text of a video contains every word
+    bool containsAll(quint32 id, const QStringList &queryWords) const;
+
+    // Rewrite the text pool and the trigram lists without removed videos
+    void compact();
+
+    QString texts;                                 // Folded text of every video back to back
+    std::vector<TextSpan> spans;                   // Text of every id
+    int deadChars = 0;                             // Characters in the pool no longer referenced
+    QHash<quint64, std::vector<quint32>> postings; // Ids whose text contained each trigram, ascending
+    QString lastQuery;                             // Folded words of the previous query, joined by spaces
+    QStringList lastWords;                         // The same words, split
+    std::vector<quint32> lastResults;              // What the previous query returned
+};
+
+#endif // SEARCHINDEX_H
@@ -0,0 +1,104 @@
+#include "seekScheduler.h"
+#include <QMediaPlayer>
+
+namespace {
+
+const int landTimeoutMs = 250;      // Longest a seek is waited for before the next one is issued anyway
+const qint64 landToleranceMs = 250; // A reported position this close to the target means the seek landed
+const qint64 minScrubStepMs = 100;  // Finest grid for scrubbing, for short videos
+const int scrubSteps = 1000;        // Grid size for scrubbing: a step per thousandth of the video
+
+}
+
+SeekScheduler::SeekScheduler(QObject *parent)
+    : QObject(parent)
+{
+    landTimeout.setSingleShot(true);
+    landTimeout.setInterval(landTimeoutMs);
+    connect(&landTimeout, &QTimer::timeout, this, &SeekScheduler::onLandTimeout);
+}
+
+void SeekScheduler::setPlayer(QMediaPlayer *newPlayer)
+{
+    if (player) {
+        disconnect(player, nullptr, this, nullptr);
+    }
+    player = newPlayer;
+    inFlight = false;
+    waiting = -1;
+    lastIssued = -1;
+    landTimeout.stop();
+    if (player) {
+        connect(player, &QMediaPlayer::positionChanged, this, &SeekScheduler::onPositionChanged);
+    }
+}
+
+void SeekScheduler::scrub(qint64 position)
+{
+    // Positions within one grid step of each other land on the same target, which is only sought once
+    qint64 step = scrubStep();
+    qint64 target = (position + step / 2) / step * step;
+    if (target == (waiting >= 0 ? waiting : lastIssued)) {
+        return;
+    }
+    waiting = target;
+    issue();
+}
+
+void SeekScheduler::seek(qint64 position)
+{
+    waiting = qMax<qint64>(0, position);
+    issue();
+}
+
+void SeekScheduler::onPositionChanged(qint64 position)
+{
+    if (!inFlight) {
+        return;  // Ordinary playback progress
+    }
+
+    // Ticks from before the seek may still be queued; only a position near the target means it landed.
+    // Backends snap to key frames, so the tolerance grows with the scrub grid.
+    qint64 tolerance = qMax(landToleranceMs, scrubStep());
+    if (qAbs(position - lastIssued) > tolerance) {
+        return;
+    }
+    landed();
+}
+
+void SeekScheduler::onLandTimeout()
+{
+    if (inFlight) {
+        landed();
+    }
+}
+
+void SeekScheduler::landed()
+{
+    inFlight = false;
+    landTimeout.stop();
+    issue();
+}
+
+void SeekScheduler::issue()
+{
+    if (!player || inFlight || waiting < 0) {
+        return;
+    }
+
+    qint64 target = waiting;
+    waiting = -1;
+    if (target == lastIssued && target == player->position()) {
+        return;  // Already there
+    }
+    inFlight = true;
+    lastIssued = target;
+    landTimeout.start();
+    player->setPosition(target);
+}
+
+qint64 SeekScheduler::scrubStep() const
+{
+    qint64 duration = player ? player->duration() : 0;
+    return qMax(minScrubStepMs, duration / scrubSteps);
+}
@@ -0,0 +1,61 @@
+#ifndef SEEKSCHEDULER_H
+#define SEEKSCHEDULER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+class QMediaPlayer;
+
+// SeekScheduler stands between the progress slider and the media player. It keeps
+// only the latest target and never has more than one seek in flight: a new target
+// arriving while the backend is still seeking replaces the waiting one instead of
+// queueing behind it. While the slider is dragged, targets are snapped to a coarse
+// grid so small movements do not cost a seek each; releasing the slider does one
+// exact seek to where it ended up. A seek counts as landed once the player reports
+// a position close to its target, or after a short timeout, whichever comes first.
+class SeekScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Constructor: the scheduler starts without a player
+    explicit SeekScheduler(QObject *parent = nullptr);
+
+    // Seek the given player from now on; anything waiting for the previous one is dropped
+    void setPlayer(QMediaPlayer *player);
+
+    // Move towards a position while the user drags; cheap and approximate
+    void scrub(qint64 position);
+
+    // Move to exactly the given position, e.g. once the slider is released
+    void seek(qint64 position);
+
+    // Whether a seek is in flight or waiting
+    bool isBusy() const { return inFlight || waiting >= 0; }
+
+private slots:
+    // The player reported a position; the seek in flight has landed once it is near the target
+    void onPositionChanged(qint64 position);
+
+    // The backend took too long to report the target; go on as if the seek had landed
+    void onLandTimeout();
+
+private:
+    // The seek in flight is done; issue the waiting target, if any
+    void landed();
+
+    // Issue the waiting target if nothing is in flight
+    void issue();
+
+    // Grid scrub targets are snapped to, so a drag only seeks when it has moved a noticeable step
+    qint64 scrubStep() const;
+
+    QPointer<QMediaPlayer> player;   // Player being seeked; it belongs to the player pool
+    bool inFlight = false;           // Whether the backend is still working on a seek
+    qint64 waiting = -1;             // Latest target not issued yet, or -1
+    qint64 lastIssued = -1;          // Target of the most recent seek
+    QTimer landTimeout;              // Treats a seek as landed if the backend never reports a position
+};
+
+#endif // SEEKSCHEDULER_H
@@ -0,0 +1,24 @@
+QT       += core gui testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tomeoTests
+
+# The classes under test are built from the player's own sources
+INCLUDEPATH += ..
+
+SOURCES += \
+    ../commentFilter.cpp \
+    ../commentTrack.cpp \
+    ../mediaLibrary.cpp \
+    ../searchIndex.cpp \
+    ../thumbnailCache.cpp \
+    tomeoTests.cpp
+
+HEADERS += \
+    ../commentFilter.h \
+    ../commentTrack.h \
+    ../mediaLibrary.h \
+    ../searchIndex.h \
+    ../thumbnailCache.h
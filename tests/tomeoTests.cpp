@@ -0,0 +1,404 @@
+// Unit tests for the parts of the player that work without a window or a media backend:
+// the search index, natural name order, the blocked-word filter, the comment log and the
+// thumbnail cache. Files are written to a temporary folder or Qt's test locations only.
+
+#include "commentFilter.h"
+#include "commentTrack.h"
+#include "mediaLibrary.h"
+#include "searchIndex.h"
+#include "thumbnailCache.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QtTest>
+
+namespace {
+
+// A scanned video without a thumbnail
+MediaLibrary::ScannedVideo video(const QString &fileName)
+{
+    return MediaLibrary::ScannedVideo{fileName, 1000, 0, -1, 0, QString()};
+}
+
+// A comment at the given playback time
+CommentTrack::Comment comment(qint64 time, const QString &text)
+{
+    CommentTrack::Comment made;
+    made.time = time;
+    made.author = "Tester";
+    made.text = text;
+    made.posted = 1000 + time;
+    return made;
+}
+
+// The texts of every comment of a track, in track order
+QStringList texts(const CommentTrack &track)
+{
+    QStringList all;
+    for (int i = 0; i < track.count(); ++i) {
+        all << track.text(i);
+    }
+    return all;
+}
+
+// Overwrite bytes of a file in place
+void patch(const QString &filePath, qint64 offset, const QByteArray &bytes)
+{
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.seek(offset));
+    QCOMPARE(file.write(bytes), qint64(bytes.size()));
+}
+
+}
+
+class TomeoTests : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void searchFindsEveryWord();
+    void searchRefinesPrefix();
+    void searchForgetsRemovedVideos();
+
+    void naturalNameOrder();
+    void sortByDurationAndPlays();
+
+    void filterMatchesWordsFromFile();
+    void filterTakesNewWords();
+
+    void logRoundTrip();
+    void logCutsTornTail();
+    void logStopsAtBadChecksum();
+    void logSalvagesDamagedSortedPart();
+
+    void thumbnailCacheRoundTrip();
+    void thumbnailCacheCutsTornTail();
+
+private:
+    QTemporaryDir dir;  // Holds the comment logs and the word list
+};
+
+void TomeoTests::initTestCase()
+{
+    QVERIFY(dir.isValid());
+    QStandardPaths::setTestModeEnabled(true);  // Caches go to Qt's test folders, not the user's
+}
+
+void TomeoTests::searchFindsEveryWord()
+{
+    SearchIndex index;
+    index.insert(0, "Holiday Beach.mp4  1:20  H.264");
+    index.insert(1, "beach volleyball.mov");
+    index.insert(2, "Mountain hike.mp4  H.264");
+
+    QCOMPARE(index.search("beach"), (std::vector<quint32>{0, 1}));
+    QCOMPARE(index.search("BEACH h.264"), (std::vector<quint32>{0}));
+    QCOMPARE(index.search("h.264"), (std::vector<quint32>{0, 2}));
+    QCOMPARE(index.search("xyz"), std::vector<quint32>());
+    QCOMPARE(index.search("  "), std::vector<quint32>());
+    QVERIFY(index.matches(2, "hike mountain"));
+    QVERIFY(!index.matches(2, "beach"));
+}
+
+void TomeoTests::searchRefinesPrefix()
+{
+    SearchIndex index;
+    index.insert(0, "clip one");
+    index.insert(1, "clap two");
+    index.insert(2, "clip three");
+
+    // Typing on narrows the previous results, and a video indexed meanwhile is still considered
+    QCOMPARE(index.search("cl"), (std::vector<quint32>{0, 1, 2}));
+    QCOMPARE(index.search("cli"), (std::vector<quint32>{0, 2}));
+    index.insert(3, "clip four");
+    QCOMPARE(index.search("clip"), (std::vector<quint32>{0, 2, 3}));
+    QCOMPARE(index.search("clip t"), (std::vector<quint32>{2}));
+
+    // Deleting characters widens the search again instead of refining the last results
+    QCOMPARE(index.search("clip"), (std::vector<quint32>{0, 2, 3}));
+    QCOMPARE(index.search("c"), (std::vector<quint32>{0, 1, 2, 3}));
+
+    // Re-indexing a video with other text takes it out of the refined results
+    QCOMPARE(index.search("clip"), (std::vector<quint32>{0, 2, 3}));
+    index.insert(2, "clap three");
+    QCOMPARE(index.search("clip "), (std::vector<quint32>{0, 3}));
+}
+
+void TomeoTests::searchForgetsRemovedVideos()
+{
+    SearchIndex index;
+    index.insert(0, "first clip");
+    index.insert(1, "second clip");
+    QCOMPARE(index.search("clip"), (std::vector<quint32>{0, 1}));
+    index.remove(0);
+    QCOMPARE(index.search("clip"), (std::vector<quint32>{1}));
+    QVERIFY(!index.matches(0, "first"));
+}
+
+void TomeoTests::naturalNameOrder()
+{
+    MediaLibrary library;
+    library.reset(dir.path());
+    library.insertAll({video("clip 10.mp4"), video("clip 9b.mp4"), video("Clip 1.mp4"),
+                       video("clip 100.mp4"), video("clip 007.mp4"), video("clip 2.mp4")});
+    QCOMPARE(library.count(), 6);
+
+    QStringList ordered;
+    for (int index : library.sortedIndices(MediaLibrary::SortByName)) {
+        ordered << library.fileName(index);
+    }
+    QCOMPARE(ordered, (QStringList{"Clip 1.mp4", "clip 2.mp4", "clip 007.mp4", "clip 9b.mp4",
+                                   "clip 10.mp4", "clip 100.mp4"}));
+
+    int two = library.indexOf("clip 2.mp4");
+    int ten = library.indexOf("clip 10.mp4");
+    QVERIFY(library.sortsBefore(MediaLibrary::SortByName, two, ten));
+    QVERIFY(!library.sortsBefore(MediaLibrary::SortByName, ten, two));
+
+    // A second batch is merged into the same order
+    library.insertAll({video("clip 3.mp4")});
+    int three = library.indexOf("clip 3.mp4");
+    QVERIFY(three >= 0);
+    QVERIFY(library.sortsBefore(MediaLibrary::SortByName, library.indexOf("clip 2.mp4"), three));
+    QVERIFY(library.sortsBefore(MediaLibrary::SortByName, three, library.indexOf("clip 007.mp4")));
+}
+
+void TomeoTests::sortByDurationAndPlays()
+{
+    MediaLibrary library;
+    library.reset(dir.path());
+    library.insertAll({video("a.mp4"), video("b.mp4"), video("c.mp4")});
+
+    MediaLibrary::MediaInfo info;
+    info.duration = 5000;
+    info.plays = 1;
+    library.setInfo(library.indexOf("a.mp4"), info);
+    info.duration = 1000;
+    info.plays = 7;
+    library.setInfo(library.indexOf("c.mp4"), info);
+
+    // Unknown durations go last, most played first, ties by name
+    QStringList byDuration;
+    for (int index : library.sortedIndices(MediaLibrary::SortByDuration)) {
+        byDuration << library.fileName(index);
+    }
+    QCOMPARE(byDuration, (QStringList{"c.mp4", "a.mp4", "b.mp4"}));
+
+    QStringList byPlays;
+    for (int index : library.sortedIndices(MediaLibrary::SortByViews)) {
+        byPlays << library.fileName(index);
+    }
+    QCOMPARE(byPlays, (QStringList{"c.mp4", "a.mp4", "b.mp4"}));
+    QCOMPARE(library.viewCount(library.indexOf("b.mp4")), 0);
+}
+
+void TomeoTests::filterMatchesWordsFromFile()
+{
+    QString wordFile = dir.filePath("blocked-words.txt");
+    QFile file(wordFile);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    file.write("# Comment lines are skipped\nspoiler\n\nHe\nshe\nhers\n");
+    file.close();
+    qputenv("TOMEO_BLOCKED_WORDS", wordFile.toUtf8());
+
+    // The constructor waits for the first word list
+    CommentFilter filter;
+    QVERIFY(filter.isActive());
+    QVERIFY(filter.blocks("Big SPOILER ahead"));
+    QVERIFY(filter.blocks("ushers"));                   // Overlapping words, found through failure links
+    QVERIFY(filter.blocks("the end"));                  // Inside a longer word
+    QVERIFY(!filter.blocks("nothing to see"));
+    QVERIFY(!filter.blocks("spoile"));
+    QVERIFY(!filter.blocks("Comment lines are skipped"));
+    QVERIFY(!filter.blocks(QString()));
+
+    qunsetenv("TOMEO_BLOCKED_WORDS");
+}
+
+void TomeoTests::filterTakesNewWords()
+{
+    qputenv("TOMEO_BLOCKED_WORDS", dir.filePath("missing-words.txt").toUtf8());
+    CommentFilter filter;
+    QVERIFY(!filter.isActive());
+    QVERIFY(!filter.blocks("abcd"));
+
+    // Compiled in the background and swapped in once ready
+    filter.setWords({"bc", "Ünï"});
+    QTRY_VERIFY(filter.isActive());
+    QVERIFY(filter.blocks("abcd"));
+    QVERIFY(filter.blocks("ÜNÏCODE"));
+    QVERIFY(!filter.blocks("acbd"));
+
+    filter.setWords({});
+    QTRY_VERIFY(!filter.isActive());
+    QVERIFY(!filter.blocks("abcd"));
+
+    qunsetenv("TOMEO_BLOCKED_WORDS");
+}
+
+void TomeoTests::logRoundTrip()
+{
+    QString log = dir.filePath("round-trip.log");
+    QVERIFY(CommentTrack::appendToLog(log, CommentTrack::encode(comment(3000, "third"))
+                                            + CommentTrack::encode(comment(1000, "first"))));
+    QVERIFY(CommentTrack::appendToLog(log, CommentTrack::encode(comment(2000, "second"))));
+
+    // Appended records come back in time order
+    CommentTrack track;
+    QVERIFY(track.openLog(log));
+    QCOMPARE(texts(track), (QStringList{"first", "second", "third"}));
+    QCOMPARE(track.unsortedCount(), 3);
+    QCOMPARE(track.author(0), QString("Tester"));
+    QCOMPARE(track.postedAt(2), qint64(4000));
+    QCOMPARE(track.lowerBound(1500), 1);
+
+    // Compaction keeps every comment and leaves nothing unsorted
+    QVERIFY(track.writeLog(log));
+    QCOMPARE(texts(track), (QStringList{"first", "second", "third"}));
+    CommentTrack reopened;
+    QVERIFY(reopened.openLog(log));
+    QCOMPARE(texts(reopened), (QStringList{"first", "second", "third"}));
+    QCOMPARE(reopened.unsortedCount(), 0);
+
+    CommentTrack missing;
+    QVERIFY(!missing.openLog(dir.filePath("no-such.log")));
+    QVERIFY(missing.isEmpty());
+}
+
+void TomeoTests::logCutsTornTail()
+{
+    QString log = dir.filePath("torn.log");
+    QByteArray whole = CommentTrack::encode(comment(1000, "kept"));
+    QByteArray torn = CommentTrack::encode(comment(2000, "torn by a crash"));
+    QVERIFY(CommentTrack::appendToLog(log, whole + torn.left(torn.size() / 2)));
+
+    CommentTrack track;
+    QVERIFY(track.openLog(log));
+    QCOMPARE(texts(track), QStringList{"kept"});
+    track.clear();
+
+    // The half record is cut off, so the next append follows the last whole one
+    QCOMPARE(QFileInfo(log).size(), qint64(16 + whole.size()));
+    QVERIFY(CommentTrack::appendToLog(log, CommentTrack::encode(comment(3000, "after"))));
+    QVERIFY(track.openLog(log));
+    QCOMPARE(texts(track), (QStringList{"kept", "after"}));
+}
+
+void TomeoTests::logStopsAtBadChecksum()
+{
+    QString log = dir.filePath("checksum.log");
+    QByteArray first = CommentTrack::encode(comment(1000, "good"));
+    QByteArray second = CommentTrack::encode(comment(2000, "flipped"));
+    QVERIFY(CommentTrack::appendToLog(log, first + second + CommentTrack::encode(comment(3000, "after it"))));
+
+    // Flip a character of the second text; its size still fits, only the checksum tells
+    patch(log, 16 + first.size() + 32 + 2 * 6, QByteArray("X"));
+
+    CommentTrack track;
+    QVERIFY(track.openLog(log));
+    QCOMPARE(texts(track), QStringList{"good"});
+}
+
+void TomeoTests::logSalvagesDamagedSortedPart()
+{
+    QString log = dir.filePath("damaged.log");
+    QVERIFY(CommentTrack::appendToLog(log, CommentTrack::encode(comment(1000, "one"))
+                                            + CommentTrack::encode(comment(2000, "two"))
+                                            + CommentTrack::encode(comment(3000, "three"))));
+    {
+        CommentTrack track;
+        QVERIFY(track.openLog(log));
+        QVERIFY(track.writeLog(log));
+    }
+    QVERIFY(CommentTrack::appendToLog(log, CommentTrack::encode(comment(500, "appended"))));
+
+    // Give the second compacted record an impossible size
+    QByteArray one = CommentTrack::encode(comment(1000, "one"));
+    QByteArray huge(4, '\xff');
+    patch(log, 16 + one.size(), huge);
+
+    // The records that still check out are kept, including the appended one behind the damage
+    CommentTrack track;
+    QVERIFY(track.openLog(log));
+    QCOMPARE(texts(track), (QStringList{"appended", "one"}));
+
+    // The log has been rewritten with only those, in time order
+    CommentTrack reopened;
+    QVERIFY(reopened.openLog(log));
+    QCOMPARE(texts(reopened), (QStringList{"appended", "one"}));
+    QCOMPARE(reopened.unsortedCount(), 0);
+}
+
+void TomeoTests::thumbnailCacheRoundTrip()
+{
+    QImage image(64, 48, QImage::Format_RGB32);
+    image.fill(Qt::red);
+    QString path = dir.filePath("clip.png");
+
+    {
+        ThumbnailCache cache(QSize(64, 48));
+        QFile::remove(cache.cacheFilePath());
+        cache.open();
+        QVERIFY(cache.lookup(path, 100, 200).isNull());
+
+        // Appended this session: answered before the file is mapped again
+        cache.insert(path, 100, 200, image);
+        QImage found = cache.lookup(path, 100, 200);
+        QCOMPARE(found.size(), image.size());
+        QCOMPARE(found.pixel(10, 10), image.pixel(10, 10));
+        QVERIFY(cache.lookup(path, 100, 201).isNull());  // The source file has changed
+    }
+
+    // A new session reads the record straight from the mapping
+    ThumbnailCache cache(QSize(64, 48));
+    cache.open();
+    QImage found = cache.lookup(path, 100, 200);
+    QCOMPARE(found.size(), image.size());
+    QCOMPARE(found.pixel(10, 10), image.pixel(10, 10));
+
+    // A cache for another box size does not share the file
+    ThumbnailCache other(QSize(32, 24));
+    QVERIFY(other.cacheFilePath() != cache.cacheFilePath());
+}
+
+void TomeoTests::thumbnailCacheCutsTornTail()
+{
+    QImage image(40, 30, QImage::Format_RGB32);
+    image.fill(Qt::blue);
+    QString path = dir.filePath("torn.png");
+    QString cacheFile;
+    qint64 intact = 0;
+
+    {
+        ThumbnailCache cache(QSize(40, 30));
+        cacheFile = cache.cacheFilePath();
+        QFile::remove(cacheFile);
+        cache.open();
+        cache.insert(path, 10, 20, image);
+    }
+    intact = QFileInfo(cacheFile).size();
+
+    // Append the first half of a copy of the record, as if the app died while writing it
+    {
+        QFile file(cacheFile);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QByteArray record = file.readAll().mid(24);
+        QVERIFY(file.seek(intact));
+        file.write(record.left(record.size() / 2));
+    }
+    QVERIFY(QFileInfo(cacheFile).size() > intact);
+
+    ThumbnailCache cache(QSize(40, 30));
+    cache.open();
+    QCOMPARE(QFileInfo(cacheFile).size(), intact);
+    QImage found = cache.lookup(path, 10, 20);
+    QCOMPARE(found.size(), image.size());
+    QCOMPARE(found.pixel(5, 5), image.pixel(5, 5));
+}
+
+QTEST_MAIN(TomeoTests)
+#include "tomeoTests.moc"
@@ -0,0 +1,251 @@
+#include "thumbnailCache.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <cstring>
+
+namespace {
+
+// Start of the cache file; a different box size or version invalidates everything
+struct FileHeader {
+    char magic[8];        // "TOMEOTC"
+    quint32 version;      // Layout version of the records
+    quint32 boxWidth;     // Box the thumbnails were scaled to fit into
+    quint32 boxHeight;
+    quint32 reserved;
+};
+
+// Precedes every thumbnail; followed by the UTF-8 source path and the raw pixels
+struct RecordHeader {
+    quint32 magic;        // recordMagic, used to detect torn writes
+    quint32 pathBytes;    // Length of the UTF-8 source path
+    qint64 fileSize;      // Size of the source file
+    qint64 modified;      // Modification time of the source file (ms since epoch)
+    quint32 width;
+    quint32 height;
+    quint32 bytesPerLine;
+    quint32 format;
+};
+
+const char fileMagic[8] = "TOMEOTC";
+const quint32 fileVersion = 1;
+const quint32 recordMagic = 0x42485454;  // "TTHB"
+const qint64 compactThreshold = 16 * 1024 * 1024;  // Never bother compacting less than 16 MB of stale data
+
+// Records are kept 8-byte aligned so the pixel data can be used in place
+qint64 align8(qint64 value)
+{
+    return (value + 7) & ~qint64(7);
+}
+
+}
+
+ThumbnailCache::ThumbnailCache(const QSize &boxSize)
+    : box(boxSize)
+{
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+    if (mapped) {
+        file.unmap(mapped);
+    }
+    file.close();
+}
+
+QString ThumbnailCache::cacheFilePath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+           + QString("/thumbnails-%1x%2.cache").arg(box.width()).arg(box.height());
+}
+
+void ThumbnailCache::open()
+{
+    qint64 deadBytes = mapFile();
+
+    // Superseded records only cost disk space, so compact once they outweigh the live ones
+    if (deadBytes > compactThreshold && deadBytes > mappedSize / 2) {
+        compact();
+        mapFile();
+    }
+}
+
+qint64 ThumbnailCache::mapFile()
+{
+    if (mapped) {
+        file.unmap(mapped);
+        mapped = nullptr;
+    }
+    file.close();
+    index.clear();
+    appended.clear();
+    mappedSize = 0;
+
+    QDir().mkpath(QFileInfo(cacheFilePath()).absolutePath());
+    file.setFileName(cacheFilePath());
+    if (!file.open(QIODevice::ReadWrite)) {
+        qDebug() << "Warning: Couldn't open thumbnail cache " << file.fileName();
+        return 0;
+    }
+
+    // Start over if the file is empty, from an older version or for a different box size
+    FileHeader header;
+    if (file.read(reinterpret_cast<char *>(&header), sizeof(header)) != sizeof(header)
+            || std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0
+            || header.version != fileVersion
+            || header.boxWidth != quint32(box.width())
+            || header.boxHeight != quint32(box.height())) {
+        file.resize(0);
+        file.seek(0);
+        writeHeader(file);
+        file.flush();
+    }
+
+    mappedSize = file.size();
+    mapped = file.map(0, mappedSize);
+    if (!mapped) {
+        mappedSize = 0;
+        return 0;
+    }
+
+    qint64 deadBytes = 0;
+    qint64 validEnd = scanRecords(mapped, mappedSize, &deadBytes);
+
+    // Cut off a record that was only half written when the app last quit
+    if (validEnd < mappedSize) {
+        file.unmap(mapped);
+        file.resize(validEnd);
+        mappedSize = validEnd;
+        mapped = file.map(0, mappedSize);
+        if (!mapped) {
+            mappedSize = 0;
+            index.clear();
+        }
+    }
+
+    return deadBytes;
+}
+
+qint64 ThumbnailCache::scanRecords(const uchar *data, qint64 size, qint64 *deadBytes)
+{
+    qint64 offset = sizeof(FileHeader);
+
+    while (offset + qint64(sizeof(RecordHeader)) <= size) {
+        RecordHeader record;
+        std::memcpy(&record, data + offset, sizeof(record));
+
+        qint64 pathOffset = offset + sizeof(RecordHeader);
+        qint64 pixelOffset = pathOffset + align8(record.pathBytes);
+        qint64 pixelBytes = qint64(record.bytesPerLine) * record.height;
+        qint64 next = pixelOffset + align8(pixelBytes);
+
+        if (record.magic != recordMagic
+                || record.format <= QImage::Format_Invalid || record.format >= QImage::NImageFormats
+                || next > size) {
+            break;  // Everything from here on is garbage
+        }
+
+        QString path = QString::fromUtf8(reinterpret_cast<const char *>(data + pathOffset), record.pathBytes);
+
+        // A later record for the same path replaces the earlier one
+        auto existing = index.constFind(path);
+        if (existing != index.constEnd()) {
+            *deadBytes += existing->pixelOffset - existing->recordOffset + align8(qint64(existing->bytesPerLine) * existing->height);
+        }
+
+        index.insert(path, Entry{record.fileSize, record.modified, offset, pixelOffset,
+                                 record.width, record.height, record.bytesPerLine, record.format});
+        offset = next;
+    }
+
+    return offset;
+}
+
+QImage ThumbnailCache::lookup(const QString &sourcePath, qint64 fileSize, qint64 modified) const
+{
+    auto it = index.constFind(sourcePath);
+    if (it == index.constEnd() || it->fileSize != fileSize || it->modified != modified) {
+        return QImage();  // Never cached, or the source has changed since
+    }
+
+    // Records appended during this session are not part of the mapping yet
+    if (!mapped || it->pixelOffset + qint64(it->bytesPerLine) * it->height > mappedSize) {
+        return appended.value(sourcePath);
+    }
+
+    const uchar *pixels = mapped + it->pixelOffset;  // Read-only, so the image never writes into the file
+    return QImage(pixels, it->width, it->height, it->bytesPerLine, QImage::Format(it->format));
+}
+
+void ThumbnailCache::insert(const QString &sourcePath, qint64 fileSize, qint64 modified, const QImage &image)
+{
+    if (!file.isOpen() || image.isNull()) {
+        return;
+    }
+
+    // Only store formats that can be wrapped again without a colour table
+    QImage pixels = image;
+    if (pixels.format() != QImage::Format_RGB32 && pixels.format() != QImage::Format_ARGB32_Premultiplied) {
+        pixels = pixels.convertToFormat(pixels.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32);
+    }
+
+    QByteArray path = sourcePath.toUtf8();
+    RecordHeader record = {recordMagic, quint32(path.size()), fileSize, modified,
+                           quint32(pixels.width()), quint32(pixels.height()),
+                           quint32(pixels.bytesPerLine()), quint32(pixels.format())};
+    qint64 pixelBytes = qint64(pixels.bytesPerLine()) * pixels.height();
+    static const char padding[8] = {};
+
+    qint64 offset = file.size();
+    file.seek(offset);
+    file.write(reinterpret_cast<const char *>(&record), sizeof(record));
+    file.write(path);
+    file.write(padding, align8(path.size()) - path.size());
+    file.write(reinterpret_cast<const char *>(pixels.constBits()), pixelBytes);
+    file.write(padding, align8(pixelBytes) - pixelBytes);
+
+    qint64 pixelOffset = offset + sizeof(RecordHeader) + align8(path.size());
+    index.insert(sourcePath, Entry{fileSize, modified, offset, pixelOffset,
+                                   record.width, record.height, record.bytesPerLine, record.format});
+    appended.insert(sourcePath, pixels);  // Shares the pixels with the caller; a thumbnail is a few dozen KB
+}
+
+void ThumbnailCache::compact()
+{
+    if (!mapped) {
+        return;
+    }
+
+    QFile out(cacheFilePath() + ".new");
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate) || !writeHeader(out)) {
+        qDebug() << "Warning: Couldn't compact thumbnail cache " << out.fileName();
+        return;
+    }
+
+    // Copy the newest record of every source that still exists, byte for byte
+    for (auto it = index.constBegin(); it != index.constEnd(); ++it) {
+        if (!QFileInfo::exists(it.key())) {
+            continue;  // The thumbnail's source has been deleted
+        }
+        qint64 end = it->pixelOffset + align8(qint64(it->bytesPerLine) * it->height);
+        out.write(reinterpret_cast<const char *>(mapped + it->recordOffset), end - it->recordOffset);
+    }
+    out.close();
+
+    file.unmap(mapped);
+    mapped = nullptr;
+    file.close();
+    QFile::remove(cacheFilePath());
+    QFile::rename(out.fileName(), cacheFilePath());
+}
+
+bool ThumbnailCache::writeHeader(QFile &out) const
+{
+    FileHeader header = {};
+    std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.version = fileVersion;
+    header.boxWidth = box.width();
+    header.boxHeight = box.height();
+    return out.write(reinterpret_cast<const char *>(&header), sizeof(header)) == sizeof(header);
+}
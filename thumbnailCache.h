@@ -0,0 +1,70 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+// ThumbnailCache keeps pre-scaled thumbnails as raw pixels in one packed file.
+// The file is memory-mapped on open, so a warm start builds every icon straight
+// from the mapping without decoding a single PNG. Entries are keyed by the source
+// path and only match while the source file's size and modification time agree.
+class ThumbnailCache
+{
+public:
+    // Constructor: thumbnails are stored scaled to fit inside the given box
+    explicit ThumbnailCache(const QSize &boxSize);
+
+    // Destructor: unmaps and closes the cache file
+    ~ThumbnailCache();
+
+    // Map the cache file and index its records; compacts it first if it is mostly stale
+    void open();
+
+    // Return the cached thumbnail of a source image, or a null image on a miss.
+    // The result references the mapping and must be copied before the cache is reopened.
+    QImage lookup(const QString &sourcePath, qint64 fileSize, qint64 modified) const;
+
+    // Append a freshly decoded thumbnail; it supersedes any older record for the same path.
+    // Until the file is mapped again, lookups answer it from memory.
+    void insert(const QString &sourcePath, qint64 fileSize, qint64 modified, const QImage &image);
+
+    // Location of the cache file on disk; every box size has a file of its own
+    QString cacheFilePath() const;
+
+private:
+    // Where one record's pixels live inside the file
+    struct Entry {
+        qint64 fileSize;      // Size of the source file when the record was written
+        qint64 modified;      // Modification time of the source file (ms since epoch)
+        qint64 recordOffset;  // Offset of the record header in the file
+        qint64 pixelOffset;   // Offset of the raw pixel data in the file
+        quint32 width;        // Thumbnail width in pixels
+        quint32 height;       // Thumbnail height in pixels
+        quint32 bytesPerLine; // Stride of the pixel data
+        quint32 format;       // QImage::Format of the pixel data
+    };
+
+    // (Re)map the whole file and rebuild the index; returns the bytes held by superseded records
+    qint64 mapFile();
+
+    // Scan every record in the file; returns the offset just past the last complete one
+    qint64 scanRecords(const uchar *data, qint64 size, qint64 *deadBytes);
+
+    // Rewrite the file keeping only the newest record for each path
+    void compact();
+
+    // Write an empty file with just the header
+    bool writeHeader(QFile &out) const;
+
+    QSize box;                    // Box the thumbnails are scaled to fit into
+    QFile file;                   // The cache file, kept open for the mapping and appends
+    uchar *mapped = nullptr;      // Start of the mapping, or null when nothing is mapped
+    qint64 mappedSize = 0;        // Number of mapped bytes
+    QHash<QString, Entry> index;  // Newest record of every source path
+    QHash<QString, QImage> appended; // Thumbnails appended since the file was mapped, which the mapping does not cover
+};
+
+#endif // THUMBNAILCACHE_H
@@ -0,0 +1,178 @@
+#include "thumbnailLoader.h"
+#include <QDebug>
+#include <QImageReader>
+#include <QRunnable>
+#include <QThread>
+
+// A single decode job; runs on one of the loader's worker threads
+class ThumbnailTask : public QRunnable
+{
+public:
+    ThumbnailTask(ThumbnailLoader *loader, const QString &key, const QString &path, qint64 fileSize, qint64 modified,
+                  const QSize &target, quint64 generation)
+        : loader(loader), key(key), path(path), fileSize(fileSize), modified(modified), target(target), generation(generation) {}
+
+    void run() override
+    {
+        QImageReader imageReader(path);
+
+        // Let the decoder produce the target size directly; formats that cannot decode scaled are
+        // scaled by the reader right after decoding, still on this worker
+        QSize sourceSize = imageReader.size();
+        if (sourceSize.isValid() && (sourceSize.width() > target.width() || sourceSize.height() > target.height())) {
+            imageReader.setScaledSize(sourceSize.scaled(target, Qt::KeepAspectRatio));
+        }
+
+        QImage scaled = imageReader.read();  // Read the image data
+        if (scaled.isNull()) {
+            qDebug() << "Warning: Couldn't process thumbnail " << path << ", using default thumbnail.";
+        } else if (!sourceSize.isValid()) {
+            // The reader could not tell the size up front, so shrink the full image instead
+            scaled = scaled.scaled(target, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+
+        // Deliver the result (even a failed one, to free the slot) through the loader's event queue on the GUI thread
+        ThumbnailLoader *receiver = loader;
+        QString video = key;
+        QString source = path;
+        qint64 size = fileSize;
+        qint64 stamp = modified;
+        quint64 asked = generation;
+        QMetaObject::invokeMethod(loader, [receiver, video, source, size, stamp, asked, scaled]() {
+            receiver->decoded(video, source, size, stamp, asked, scaled);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    ThumbnailLoader *loader;  // Loader that receives the decoded image
+    QString key;              // Identifies the video the thumbnail belongs to
+    QString path;             // Path of the thumbnail image file
+    qint64 fileSize;          // Size of the thumbnail file, for the cache key
+    qint64 modified;          // Modification time of the thumbnail file, for the cache key
+    QSize target;             // Box to decode into, in device pixels
+    quint64 generation;       // Generation of the loader the request was made in
+};
+
+ThumbnailLoader::ThumbnailLoader(QObject *parent)
+    : QObject(parent),
+    pixels(boxSize(DesktopLevel))
+{
+    pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));  // Use every core, but never more
+}
+
+ThumbnailLoader::~ThumbnailLoader()
+{
+    pool.clear();        // Forget everything that has not started yet
+    pool.waitForDone();  // Running tasks still reference this loader
+}
+
+void ThumbnailLoader::load(const QString &key, const QString &thumbnailPath, qint64 fileSize, qint64 modified)
+{
+    if (fileSize < 0 || isPending(key) || failed.value(key, -1) == modified) {
+        return;  // No usable thumbnail (the placeholder stays in place), or it is already on its way
+    }
+
+    // A cache hit is only a copy out of the mapping, so it is delivered right away
+    QImage cached = currentCache().lookup(thumbnailPath, fileSize, modified);
+    if (!cached.isNull()) {
+        emit thumbnailReady(key, cached);
+        return;
+    }
+
+    queue.append(Request{key, thumbnailPath, fileSize, modified});
+    queuedKeys.insert(key);
+    dispatch();
+}
+
+void ThumbnailLoader::dispatch()
+{
+    while (running < pool.maxThreadCount() && !queue.isEmpty()) {
+        Request request = queue.takeFirst();
+        queuedKeys.remove(request.key);
+        inFlight.insert(request.key);
+        running++;
+        pool.start(new ThumbnailTask(this, request.key, request.thumbnailPath, request.fileSize, request.modified,
+                                     pixels, generation));
+    }
+}
+
+void ThumbnailLoader::decoded(const QString &key, const QString &thumbnailPath, qint64 fileSize, qint64 modified,
+                              quint64 requestGeneration, const QImage &image)
+{
+    running--;
+    if (requestGeneration != generation) {
+        // Asked for by a folder or level the list has since left; the key may mean another file now
+        dispatch();
+        return;
+    }
+    inFlight.remove(key);
+
+    if (!image.isNull()) {
+        currentCache().insert(thumbnailPath, fileSize, modified, image);  // Next launch will not decode this one again
+        emit thumbnailReady(key, image);
+    } else {
+        failed.insert(key, modified);  // Not worth retrying until the file changes
+    }
+
+    dispatch();  // A worker has become free
+}
+
+void ThumbnailLoader::cancelAll()
+{
+    queue.clear();
+    queuedKeys.clear();
+}
+
+void ThumbnailLoader::reset()
+{
+    cancelAll();
+    inFlight.clear();
+    failed.clear();
+    generation++;
+}
+
+bool ThumbnailLoader::setLevel(Level newLevel, qreal devicePixelRatio)
+{
+    if (newLevel == level && qFuzzyCompare(devicePixelRatio, pixelRatio)) {
+        return false;
+    }
+
+    // The caches of the other levels stay valid unless the screen density changed too
+    if (!qFuzzyCompare(devicePixelRatio, pixelRatio)) {
+        for (std::unique_ptr<ThumbnailCache> &levelCache : caches) {
+            levelCache.reset();
+        }
+    }
+
+    level = newLevel;
+    pixelRatio = devicePixelRatio;
+    pixels = boxSize(level) * pixelRatio;
+
+    // Requests so far were for the old size; decodes already running are dropped when they finish
+    cancelAll();
+    inFlight.clear();
+    generation++;
+    return true;
+}
+
+QSize ThumbnailLoader::boxSize(Level level)
+{
+    switch (level) {
+    case PhoneLevel:
+        return QSize(100, 80);
+    case TabletLevel:
+        return QSize(120, 96);
+    default:
+        return QSize(150, 120);
+    }
+}
+
+ThumbnailCache &ThumbnailLoader::currentCache()
+{
+    std::unique_ptr<ThumbnailCache> &levelCache = caches[level];
+    if (!levelCache) {
+        levelCache.reset(new ThumbnailCache(pixels));
+        levelCache->open();  // Map the thumbnails saved by earlier runs
+    }
+    return *levelCache;
+}
@@ -0,0 +1,113 @@
+#ifndef THUMBNAILLOADER_H
+#define THUMBNAILLOADER_H
+
+#include <QObject>
+#include <QImage>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include <memory>
+#include "thumbnailCache.h"
+
+// ThumbnailLoader decodes video thumbnails on a bounded pool of worker threads
+// and hands every decoded image back to the GUI thread as soon as it is ready.
+// Thumbnails found in the on-disk cache are handed back straight away without decoding.
+// Requests wait in a queue on the GUI side and only as many as there are workers are
+// handed out at a time, so callers can reorder or drop them while the user scrolls.
+// Thumbnails are decoded straight to the size the list shows them at: one level per
+// window layout, times the screen's device pixel ratio, each with its own disk cache.
+// Every decode carries the generation it was asked for in, so results that arrive after
+// a folder or size switch are dropped instead of landing on the wrong row.
+class ThumbnailLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Thumbnail sizes, one per layout of the main window
+    enum Level {
+        PhoneLevel,
+        TabletLevel,
+        DesktopLevel,
+        LevelCount
+    };
+
+    // Constructor: creates a worker pool with one thread per available core
+    explicit ThumbnailLoader(QObject *parent = nullptr);
+
+    // Destructor: drops queued work and waits for running decodes to finish
+    ~ThumbnailLoader();
+
+    // Deliver the thumbnail for the given key, from the cache or by queueing a decode. The key comes
+    // back with the image, so results still find their row after the list has changed underneath.
+    // The size and modification time come from the scan; a negative size means there is no thumbnail.
+    // Requests are served in the order they were made.
+    void load(const QString &key, const QString &thumbnailPath, qint64 fileSize, qint64 modified);
+
+    // Drop every request that has not been picked up by a worker yet
+    void cancelAll();
+
+    // Drop every request, and the results of decodes already running, e.g. when the keys are
+    // about to mean other files because the list shows another folder
+    void reset();
+
+    // Whether the thumbnail for the key is queued or being decoded right now
+    bool isPending(const QString &key) const { return inFlight.contains(key) || queuedKeys.contains(key); }
+
+    // Switch to the thumbnails of another level or screen density. Returns false if nothing changed;
+    // otherwise every request made so far is dropped, since it was for the old size.
+    bool setLevel(Level level, qreal devicePixelRatio);
+
+    // Level thumbnails are currently decoded for
+    Level currentLevel() const { return level; }
+
+    // Box a level's thumbnails are laid out in, in device-independent pixels
+    static QSize boxSize(Level level);
+
+    // Box the thumbnails are currently decoded to fit, in device pixels
+    QSize pixelSize() const { return pixels; }
+
+    // Device pixel ratio the thumbnails are currently decoded for
+    qreal devicePixelRatio() const { return pixelRatio; }
+
+signals:
+    // Emitted on the GUI thread when the thumbnail for a key has been decoded
+    void thumbnailReady(const QString &key, const QImage &image);
+
+private:
+    friend class ThumbnailTask;
+
+    // A decode that is waiting for a free worker
+    struct Request {
+        QString key;
+        QString thumbnailPath;
+        qint64 fileSize;
+        qint64 modified;
+    };
+
+    // Hand queued requests to idle workers
+    void dispatch();
+
+    // Called on the GUI thread when a decode has finished; the image is null if it failed
+    void decoded(const QString &key, const QString &thumbnailPath, qint64 fileSize, qint64 modified,
+                 quint64 requestGeneration, const QImage &image);
+
+    // Disk cache of the current level, opened on first use
+    ThumbnailCache &currentCache();
+
+    Level level = DesktopLevel; // Level thumbnails are decoded for
+    qreal pixelRatio = 0.0;  // Device pixel ratio thumbnails are decoded for; set by the first setLevel()
+    QSize pixels;            // Box of the current level in device pixels
+    std::unique_ptr<ThumbnailCache> caches[LevelCount]; // Pre-scaled thumbnails from earlier runs, per level
+    QThreadPool pool;        // Worker threads used for decoding
+    int running = 0;         // Decodes handed to the pool and not finished yet, of any generation
+    quint64 generation = 0;  // Bumped by reset() and setLevel(); decodes of an older one are dropped
+    QList<Request> queue;    // Requests not handed to a worker yet, in order
+    QSet<QString> queuedKeys; // Keys in the queue, to skip duplicate requests
+    QSet<QString> inFlight;  // Keys being decoded right now for the current level
+    QHash<QString, qint64> failed; // Keys whose thumbnail could not be decoded, with the file's mtime at the time
+};
+
+#endif // THUMBNAILLOADER_H
@@ -0,0 +1,125 @@
+#include "thumbnailPrefetcher.h"
+#include "mediaLibrary.h"
+#include "thumbnailLoader.h"
+#include "videoListModel.h"
+#include <QEvent>
+#include <QListView>
+#include <QScrollBar>
+
+namespace {
+
+const int pagesAhead = 2;  // Screens of rows prefetched in the direction of scrolling
+
+}
+
+ThumbnailPrefetcher::ThumbnailPrefetcher(QListView *view, VideoListModel *model, MediaLibrary *library,
+                                         ThumbnailLoader *loader, QObject *parent)
+    : QObject(parent),
+    view(view),
+    model(model),
+    library(library),
+    loader(loader)
+{
+    // Everything that can change which rows are on screen ends up in one refresh
+    refreshTimer.setSingleShot(true);
+    refreshTimer.setInterval(0);
+    connect(&refreshTimer, &QTimer::timeout, this, &ThumbnailPrefetcher::refresh);
+
+    connect(view->verticalScrollBar(), &QScrollBar::valueChanged, this, &ThumbnailPrefetcher::onScrolled);
+    connect(model, &QAbstractItemModel::rowsInserted, this, &ThumbnailPrefetcher::schedule);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, &ThumbnailPrefetcher::schedule);
+    connect(model, &QAbstractItemModel::modelReset, this, &ThumbnailPrefetcher::schedule);
+    connect(model, &QAbstractItemModel::layoutChanged, this, &ThumbnailPrefetcher::schedule);
+    view->viewport()->installEventFilter(this);
+
+    budget = model->thumbnailBudget();
+    int budgetMb = qEnvironmentVariableIntValue("TOMEO_THUMBNAIL_BUDGET_MB");
+    if (budgetMb > 0) {
+        setMemoryBudget(qint64(budgetMb) * 1024 * 1024);
+    }
+}
+
+void ThumbnailPrefetcher::setMemoryBudget(qint64 bytes)
+{
+    budget = bytes;
+    model->setThumbnailBudget(budget);
+    schedule();
+}
+
+void ThumbnailPrefetcher::schedule()
+{
+    refreshTimer.start();
+}
+
+bool ThumbnailPrefetcher::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == view->viewport() && (event->type() == QEvent::Resize || event->type() == QEvent::Show)) {
+        schedule();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void ThumbnailPrefetcher::onScrolled(int value)
+{
+    if (value != lastScrollValue) {
+        scrollDirection = value > lastScrollValue ? 1 : -1;
+        lastScrollValue = value;
+    }
+    schedule();
+}
+
+void ThumbnailPrefetcher::refresh()
+{
+    int rows = model->rowCount();
+    if (rows == 0 || !view->isVisible()) {
+        return;  // Nothing on screen; a Show event brings us back
+    }
+
+    // Rows that are on screen right now
+    QModelIndex top = view->indexAt(QPoint(1, 1));
+    QModelIndex bottom = view->indexAt(QPoint(1, view->viewport()->height() - 2));
+    int first = top.isValid() ? top.row() : 0;
+    int last = bottom.isValid() ? bottom.row() : rows - 1;
+    int page = last - first + 1;
+
+    // Anything still queued was wanted for an older scroll position
+    loader->cancelAll();
+
+    // Visible rows first, then ahead in the scroll direction, then half a screen behind
+    for (int row = first; row <= last; ++row) {
+        request(row);
+    }
+    for (int step = 1; step <= page * pagesAhead; ++step) {
+        int row = scrollDirection > 0 ? last + step : first - step;
+        if (row >= 0 && row < rows) {
+            request(row);
+        }
+    }
+    for (int step = 1; step <= page / 2; ++step) {
+        int row = scrollDirection > 0 ? first - step : last + step;
+        if (row >= 0 && row < rows) {
+            request(row);
+        }
+    }
+
+    applyBudget(page * (1 + pagesAhead) + page / 2);
+}
+
+void ThumbnailPrefetcher::request(int row)
+{
+    int index = model->libraryIndex(row);
+    QString fileName = library->fileName(index);
+    if (model->hasThumbnail(fileName)) {
+        return;
+    }
+    loader->load(fileName, library->thumbnailPath(index), library->thumbnailSize(index), library->thumbnailModified(index));
+}
+
+void ThumbnailPrefetcher::applyBudget(int rowsWanted)
+{
+    // Twice the wanted rows, so prefetched thumbnails never push the visible ones out
+    QSize pixels = loader->pixelSize();
+    qint64 bytesPerThumbnail = qint64(pixels.width()) * pixels.height() * 4;
+    qint64 needed = qint64(rowsWanted) * 2 * bytesPerThumbnail;
+    model->setThumbnailBudget(qMax(budget, needed));
+}
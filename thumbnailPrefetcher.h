@@ -0,0 +1,61 @@
+#ifndef THUMBNAILPREFETCHER_H
+#define THUMBNAILPREFETCHER_H
+
+#include <QObject>
+#include <QTimer>
+
+class QListView;
+class MediaLibrary;
+class ThumbnailLoader;
+class VideoListModel;
+
+// ThumbnailPrefetcher decides which thumbnails the video list needs. Whenever the
+// view scrolls, resizes or its rows change, it asks the loader for the visible rows
+// first, then a few screens ahead in the direction of scrolling and a little behind.
+// Everything else is left to the model's memory budget, so resident memory follows
+// the size of the viewport rather than the size of the library.
+class ThumbnailPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Constructor: watches the view and its model; none of them are owned
+    ThumbnailPrefetcher(QListView *view, VideoListModel *model, MediaLibrary *library,
+                        ThumbnailLoader *loader, QObject *parent = nullptr);
+
+    // Memory budget for resident thumbnails; never less than what a few screens of rows need.
+    // Defaults to TOMEO_THUMBNAIL_BUDGET_MB when set.
+    void setMemoryBudget(qint64 bytes);
+
+    // Work out the wanted rows again (coalesced to once per event loop pass)
+    void schedule();
+
+protected:
+    // Notices resizes of the view's viewport
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    // Track the direction of scrolling, then refresh
+    void onScrolled(int value);
+
+    // Queue the thumbnails of the rows around the viewport, nearest first
+    void refresh();
+
+private:
+    // Queue one row's thumbnail unless it is already resident or on its way
+    void request(int row);
+
+    // Keep the model's budget large enough for the rows the prefetcher asks for
+    void applyBudget(int rowsWanted);
+
+    QListView *view;           // The video list
+    VideoListModel *model;     // Holds the resident thumbnails
+    MediaLibrary *library;     // Where each row's thumbnail lives on disk
+    ThumbnailLoader *loader;   // Decodes the thumbnails
+    QTimer refreshTimer;       // Coalesces bursts of scroll and model events
+    qint64 budget;             // Requested memory budget for resident thumbnails
+    int lastScrollValue = 0;   // Scroll position at the previous refresh
+    int scrollDirection = 1;   // +1 when scrolling down, -1 when scrolling up
+};
+
+#endif // THUMBNAILPREFETCHER_H
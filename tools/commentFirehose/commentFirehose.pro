@@ -0,0 +1,10 @@
+QT       += core network
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = commentFirehose
+
+SOURCES += \
+    main.cpp
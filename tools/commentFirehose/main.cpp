@@ -0,0 +1,113 @@
+// commentFirehose streams live comments into a running Tomeo at a fixed rate, to load-test
+// its ingest endpoint. Comments are replayed from a text file, one per line ("author<TAB>text"
+// or just the text), looping at the end; without a file, numbered comments are made up.
+// Once a second it prints how many comments were sent and how far it fell behind the rate
+// because the player stopped reading, which is how its backpressure shows from outside.
+//
+// Usage: commentFirehose [--server name] [--rate comments/s] [--seconds n] [file]
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLocalSocket>
+#include <QStringList>
+#include <QTextStream>
+#include <QTimer>
+
+namespace {
+
+const int tickMs = 10;                          // Writes are issued in small steps to keep the rate even
+const qint64 maxBacklogBytes = 1024 * 1024;     // Unsent bytes allowed before writing pauses
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Streams live comments into Tomeo at a fixed rate.");
+    parser.addHelpOption();
+    QCommandLineOption serverOption("server", "Local socket name of the player.", "name", "tomeo-comments");
+    QCommandLineOption rateOption("rate", "Comments per second.", "count", "1000");
+    QCommandLineOption secondsOption("seconds", "Stop after this many seconds; 0 runs until interrupted.", "n", "0");
+    parser.addOption(serverOption);
+    parser.addOption(rateOption);
+    parser.addOption(secondsOption);
+    parser.addPositionalArgument("file", "Comments to replay, one per line.");
+    parser.process(app);
+
+    QList<QByteArray> lines;
+    if (!parser.positionalArguments().isEmpty()) {
+        QFile file(parser.positionalArguments().first());
+        if (!file.open(QIODevice::ReadOnly)) {
+            out << "Cannot read " << file.fileName() << Qt::endl;
+            return 1;
+        }
+        while (!file.atEnd()) {
+            QByteArray line = file.readLine().trimmed();
+            if (!line.isEmpty()) {
+                lines.append(line + '\n');
+            }
+        }
+    }
+
+    qint64 rate = qMax(1, parser.value(rateOption).toInt());
+    qint64 seconds = parser.value(secondsOption).toInt();
+
+    QLocalSocket socket;
+    socket.connectToServer(parser.value(serverOption));
+    if (!socket.waitForConnected(3000)) {
+        out << "Cannot connect to " << parser.value(serverOption) << ": " << socket.errorString() << Qt::endl;
+        return 1;
+    }
+    QObject::connect(&socket, &QLocalSocket::disconnected, &app, [&]() {
+        out << "The player closed the connection" << Qt::endl;
+        app.exit(1);
+    });
+
+    QElapsedTimer clock;
+    clock.start();
+    qint64 sent = 0;
+    qint64 behind = 0;
+    qint64 lastReport = 0;
+    qint64 sentAtReport = 0;
+
+    QTimer ticker;
+    ticker.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&ticker, &QTimer::timeout, &app, [&]() {
+        qint64 elapsed = clock.elapsed();
+        if (seconds > 0 && elapsed >= seconds * 1000) {
+            socket.flush();
+            socket.waitForBytesWritten(3000);
+            out << "Sent " << sent << " comments in " << elapsed / 1000.0 << " s" << Qt::endl;
+            app.quit();
+            return;
+        }
+
+        // Keep to the rate over the whole run; what could not be written is made up once the player reads again
+        qint64 due = elapsed * rate / 1000;
+        while (sent < due) {
+            if (socket.bytesToWrite() > maxBacklogBytes) {
+                behind = qMax(behind, due - sent);
+                break;
+            }
+            socket.write(lines.isEmpty() ? QByteArray("Firehose\tComment " + QByteArray::number(sent) + '\n')
+                                         : lines.at(int(sent % lines.size())));
+            sent++;
+        }
+
+        if (elapsed - lastReport >= 1000) {
+            out << "Sent " << sent - sentAtReport << " comments/s, up to " << behind << " behind the rate, "
+                << socket.bytesToWrite() << " bytes unsent" << Qt::endl;
+            lastReport = elapsed;
+            sentAtReport = sent;
+            behind = 0;
+        }
+    });
+    ticker.start(tickMs);
+
+    return app.exec();
+}
@@ -0,0 +1,18 @@
+QT       += core gui widgets
+
+CONFIG += c++17
+CONFIG -= app_bundle
+
+TARGET = danmakuBench
+
+# The overlay is built from the player's own sources
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../commentRenderer.cpp \
+    ../../danmakuOverlay.cpp \
+    main.cpp
+
+HEADERS += \
+    ../../commentRenderer.h \
+    ../../danmakuOverlay.h
@@ -0,0 +1,113 @@
+// danmakuBench feeds a DanmakuOverlay a synthetic stream of comments at a fixed rate, in a
+// window the size of a typical video, and once a second prints how many comments are in
+// flight, waiting and dropped, the frame rate and how long painting took. It measures the
+// overlay alone, without a video or the rest of the player behind it.
+//
+// Usage: danmakuBench [--rate comments/s] [--seconds n] [--size WxH]
+
+#include "danmakuOverlay.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QTimer>
+#include <QWidget>
+
+namespace {
+
+const int tickMs = 10;  // Comments are launched in small steps to keep the rate even
+
+// Times every paint of the overlay
+class TimedOverlay : public DanmakuOverlay
+{
+public:
+    using DanmakuOverlay::DanmakuOverlay;
+
+    int frames = 0;           // Frames painted in the current window
+    qint64 paintNs = 0;       // Paint time in the current window
+    qint64 paintMaxNs = 0;    // Longest paint in the current window
+
+protected:
+    void paintEvent(QPaintEvent *event) override
+    {
+        QElapsedTimer paintClock;
+        paintClock.start();
+        DanmakuOverlay::paintEvent(event);
+        qint64 elapsed = paintClock.nsecsElapsed();
+        frames++;
+        paintNs += elapsed;
+        paintMaxNs = qMax(paintMaxNs, elapsed);
+    }
+};
+
+}
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures the danmaku overlay under a synthetic comment stream.");
+    parser.addHelpOption();
+    QCommandLineOption rateOption("rate", "Comments per second.", "count", "200");
+    QCommandLineOption secondsOption("seconds", "Stop after this many seconds; 0 runs until the window is closed.", "n", "30");
+    QCommandLineOption sizeOption("size", "Size of the video area.", "WxH", "1280x720");
+    parser.addOption(rateOption);
+    parser.addOption(secondsOption);
+    parser.addOption(sizeOption);
+    parser.process(app);
+
+    qint64 rate = qMax(1, parser.value(rateOption).toInt());
+    qint64 seconds = parser.value(secondsOption).toInt();
+    QStringList size = parser.value(sizeOption).split('x');
+    int width = size.size() == 2 ? size.at(0).toInt() : 0;
+    int height = size.size() == 2 ? size.at(1).toInt() : 0;
+    if (width <= 0 || height <= 0) {
+        out << "Bad size " << parser.value(sizeOption) << Qt::endl;
+        return 1;
+    }
+
+    // A black stand-in for the video widget
+    QWidget video;
+    video.setStyleSheet("background: black");
+    video.resize(width, height);
+    TimedOverlay overlay(&video);
+    video.show();
+
+    QElapsedTimer clock;
+    clock.start();
+    qint64 launched = 0;
+    qint64 lastReport = 0;
+
+    QTimer ticker;
+    ticker.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&ticker, &QTimer::timeout, &app, [&]() {
+        qint64 elapsed = clock.elapsed();
+        if (seconds > 0 && elapsed >= seconds * 1000) {
+            app.quit();
+            return;
+        }
+
+        // Keep the stream at its rate however long the frames take
+        qint64 due = elapsed * rate / 1000;
+        while (launched < due) {
+            overlay.launch(QString("Benchmark comment %1").arg(launched++));
+        }
+
+        qint64 window = elapsed - lastReport;
+        if (window >= 1000) {
+            out << overlay.activeCount() << " in flight, " << overlay.waitingCount() << " waiting, "
+                << overlay.droppedCount() << " dropped, " << overlay.frames * 1000.0 / window << " fps, paint "
+                << (overlay.frames > 0 ? overlay.paintNs / 1e6 / overlay.frames : 0.0) << " ms average, "
+                << overlay.paintMaxNs / 1e6 << " ms longest" << Qt::endl;
+            lastReport = elapsed;
+            overlay.frames = 0;
+            overlay.paintNs = 0;
+            overlay.paintMaxNs = 0;
+        }
+    });
+    ticker.start(tickMs);
+
+    return app.exec();
+}
@@ -0,0 +1,117 @@
+#include "videoItemDelegate.h"
+#include "videoListModel.h"
+#include <QApplication>
+#include <QFontDatabase>
+#include <QPainter>
+
+namespace {
+
+const int verticalPadding = 15;      // Padding above and below the row contents
+const int horizontalPadding = 10;    // Padding left and right of the row contents
+const int spacing = 10;              // Gap between the thumbnail and the text
+
+}
+
+VideoItemDelegate::VideoItemDelegate(QObject *parent)
+    : QStyledItemDelegate(parent),
+    thumbnailBox(150, 120),
+    titleFont("Comic Sans MS", 12, QFont::Bold),  // Set font for the title
+    viewCountFont("Comic Sans MS", 8)             // Set font for the view count text
+{
+    // Set up font for the view count icon
+    int fontId = QFontDatabase::addApplicationFont(":/iconfont.ttf");
+    QString fontName = QFontDatabase::applicationFontFamilies(fontId).at(0);
+    viewIconFont = QFont(fontName);
+    viewIconFont.setPixelSize(30);  // Set font size for the view count icon
+}
+
+void VideoItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    // Let the style draw the row background, so the list's stylesheet still decides the selection colour
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+    const QWidget *widget = opt.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &opt, painter, widget);
+
+    painter->save();
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+
+    QRect content = option.rect.adjusted(horizontalPadding, verticalPadding, -horizontalPadding, -verticalPadding);
+
+    // Thumbnail, centred in its box
+    QRect thumbRect(content.topLeft(), thumbnailBox);
+    QPixmap thumbnail = qvariant_cast<QPixmap>(index.data(Qt::DecorationRole));
+    if (!thumbnail.isNull()) {
+        // Thumbnails carry the screen's pixel ratio, so fit their logical size
+        QSize fitted = (QSizeF(thumbnail.size()) / thumbnail.devicePixelRatioF()).toSize().scaled(thumbnailBox, Qt::KeepAspectRatio);
+        QRect target(QPoint(0, 0), fitted);
+        target.moveCenter(thumbRect.center());
+        painter->drawPixmap(target, thumbnail);
+    }
+
+    // Title on the upper part of the text column, view count below it
+    QRect textRect(thumbRect.right() + spacing, content.top(), content.right() - thumbRect.right() - spacing, content.height());
+    QRect titleRect(textRect.left(), textRect.top(), textRect.width(), textRect.height() * 3 / 5);
+    QRect viewRect(textRect.left(), titleRect.bottom(), textRect.width(), textRect.bottom() - titleRect.bottom());
+
+    painter->setFont(titleFont);
+    painter->setPen(Qt::white);  // Set the font color of the title
+    painter->drawText(titleRect, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextWordWrap, index.data(Qt::DisplayRole).toString());
+
+    QString viewIcon = QChar(0xe603);  // View count icon (using Unicode character)
+    painter->setFont(viewIconFont);
+    painter->setPen(QColor("pink"));  // Set color for the view count icon
+    int iconWidth = QFontMetrics(viewIconFont).horizontalAdvance(viewIcon);
+    painter->drawText(viewRect, Qt::AlignLeft | Qt::AlignVCenter, viewIcon);
+
+    // View count, followed by whatever the indexer has found out about the video so far
+    QStringList details;
+    details << "Views: " + QString::number(index.data(VideoListModel::ViewCountRole).toInt());
+    qint64 duration = index.data(VideoListModel::DurationRole).toLongLong();
+    if (duration >= 0) {
+        details << formatDuration(duration);
+    }
+    QSize resolution = index.data(VideoListModel::ResolutionRole).toSize();
+    if (resolution.isValid() && !resolution.isEmpty()) {
+        details << QString("%1x%2").arg(resolution.width()).arg(resolution.height());
+    }
+    QString codec = index.data(VideoListModel::VideoCodecRole).toString();
+    if (!codec.isEmpty()) {
+        details << codec;
+    }
+
+    QRect countRect = viewRect.adjusted(iconWidth + spacing / 2, 0, 0, 0);
+    painter->setFont(viewCountFont);
+    painter->setPen(QColor("#D3D3D3"));  // Set the font color for the view count
+    QString countText = QFontMetrics(viewCountFont).elidedText(details.join("  |  "), Qt::ElideRight, countRect.width());
+    painter->drawText(countRect, Qt::AlignLeft | Qt::AlignVCenter, countText);
+
+    painter->restore();
+}
+
+QSize VideoItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    Q_UNUSED(index);
+
+    // Every row has the same height, which lets the view skip measuring rows it never shows
+    return QSize(option.rect.width(), thumbnailBox.height() + 2 * verticalPadding);
+}
+
+QString VideoItemDelegate::formatDuration(qint64 milliseconds)
+{
+    qint64 seconds = milliseconds / 1000;
+    if (seconds >= 3600) {
+        return QString("%1:%2:%3").arg(seconds / 3600).arg(seconds / 60 % 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+    }
+    return QString("%1:%2").arg(seconds / 60).arg(seconds % 60, 2, 10, QChar('0'));
+}
+
+void VideoItemDelegate::setThumbnailBox(const QSize &box)
+{
+    if (box == thumbnailBox) {
+        return;
+    }
+    thumbnailBox = box;
+    emit sizeHintChanged(QModelIndex());  // Every row has the same height, so one signal covers them all
+}
@@ -0,0 +1,35 @@
+#ifndef VIDEOITEMDELEGATE_H
+#define VIDEOITEMDELEGATE_H
+
+#include <QFont>
+#include <QStyledItemDelegate>
+
+// VideoItemDelegate paints one row of the video list: the thumbnail on the left,
+// the title next to it, and below the title the view count followed by the duration,
+// frame size and codec once MediaIndexer has found them. Nothing is built per row,
+// so only the rows currently on screen cost anything.
+class VideoItemDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    // Constructor: sets up the fonts shared by every row
+    explicit VideoItemDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    // Space reserved for the thumbnail in every row; the view lays its rows out again
+    void setThumbnailBox(const QSize &box);
+
+private:
+    // Duration as m:ss, or h:mm:ss for long videos
+    static QString formatDuration(qint64 milliseconds);
+
+    QSize thumbnailBox;   // Space reserved for the thumbnail in every row
+    QFont titleFont;      // Font of the video title
+    QFont viewIconFont;   // Icon font for the view count glyph
+    QFont viewCountFont;  // Font of the view count text
+};
+
+#endif // VIDEOITEMDELEGATE_H
@@ -0,0 +1,414 @@
+#include "videoListModel.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+const int maxInsertRuns = 8;  // Scattered new rows beyond this many runs are shown with one layout change
+
+}
+
+VideoListModel::VideoListModel(MediaLibrary *library, QObject *parent)
+    : QAbstractListModel(parent),
+    library(library)
+{
+    setThumbnailBudget(32 * 1024 * 1024);  // Plenty for several screens of rows
+}
+
+int VideoListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(order.size());
+}
+
+QVariant VideoListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return QVariant();
+    }
+
+    int entry = order[index.row()];
+    switch (role) {
+    case Qt::DisplayRole:
+        return library->fileName(entry);
+    case Qt::DecorationRole: {
+        // Looking the thumbnail up marks it as recently used, so on-screen rows are evicted last
+        QPixmap *thumbnail = thumbnails.object(library->fileName(entry));
+        return thumbnail ? *thumbnail : placeholder;
+    }
+    case UrlRole:
+        return library->url(entry);
+    case ViewCountRole:
+        return library->viewCount(entry);
+    case DurationRole:
+        return library->duration(entry);
+    case ResolutionRole:
+        return library->resolution(entry);
+    case VideoCodecRole:
+        return library->videoCodec(entry);
+    default:
+        return QVariant();
+    }
+}
+
+void VideoListModel::resetLibrary(const QString &folderPath)
+{
+    beginResetModel();
+    library->reset(folderPath);
+    search.clear();
+    sorted.clear();
+    order.clear();
+    rows.clear();
+    thumbnails.clear();
+    endResetModel();
+}
+
+std::vector<int> VideoListModel::addVideos(const std::vector<MediaLibrary::ScannedVideo> &videos)
+{
+    int oldCount = library->count();
+    std::vector<int> moved = library->insertAll(videos);
+
+    // The rows keep their videos; only the library indices behind them change
+    for (int &entry : order) {
+        entry = moved[entry];
+    }
+    for (int &entry : sorted) {
+        entry = moved[entry];
+    }
+    std::vector<int> shifted(library->count(), -1);
+    for (int index = 0; index < oldCount; ++index) {
+        shifted[moved[index]] = rows[index];
+    }
+    rows.swap(shifted);
+
+    std::vector<int> added;
+    std::vector<int> matching;
+    for (const MediaLibrary::ScannedVideo &video : videos) {
+        int libraryIndex = library->indexOf(video.fileName);
+        added.push_back(libraryIndex);
+        quint32 id = library->id(libraryIndex);
+        search.insert(id, searchText(libraryIndex));
+        if (filter.isEmpty() || search.matches(id, filter)) {
+            matching.push_back(libraryIndex);
+        }
+    }
+    showVideos(std::move(matching));
+
+    // The new videos are merged into the sorted library, which stays sorted without sorting it again
+    auto before = [this](int entry, int video) { return library->sortsBefore(sorting, entry, video); };
+    std::sort(added.begin(), added.end(), before);
+    std::vector<int> merged;
+    merged.reserve(sorted.size() + added.size());
+    std::merge(sorted.begin(), sorted.end(), added.begin(), added.end(), std::back_inserter(merged), before);
+    sorted.swap(merged);
+    return moved;
+}
+
+void VideoListModel::removeVideo(int libraryIndex)
+{
+    thumbnails.remove(library->fileName(libraryIndex));
+    search.remove(library->id(libraryIndex));
+    if (rows[libraryIndex] >= 0) {
+        hideVideo(libraryIndex);
+    }
+
+    unsortVideo(libraryIndex);
+
+    // Everything after the removed video moves up one place in the library
+    library->remove(libraryIndex);
+    rows.erase(rows.begin() + libraryIndex);
+    for (int &entry : order) {
+        if (entry > libraryIndex) {
+            entry--;
+        }
+    }
+    for (int &entry : sorted) {
+        if (entry > libraryIndex) {
+            entry--;
+        }
+    }
+}
+
+void VideoListModel::setFileStamp(int libraryIndex, qint64 fileSize, qint64 modified)
+{
+    bool resort = sorting == MediaLibrary::SortByDateAdded;
+    if (resort) {
+        unsortVideo(libraryIndex);
+    }
+    library->setFileStamp(libraryIndex, fileSize, modified);
+    if (resort) {
+        sortVideo(libraryIndex);
+    }
+    if (resort && rows[libraryIndex] >= 0) {
+        resortVideo(libraryIndex);
+    }
+}
+
+void VideoListModel::setInfo(int libraryIndex, const MediaLibrary::MediaInfo &info)
+{
+    bool resort = sorting == MediaLibrary::SortByDuration || sorting == MediaLibrary::SortByViews;
+    if (resort) {
+        unsortVideo(libraryIndex);
+    }
+    library->setInfo(libraryIndex, info);
+    if (resort) {
+        sortVideo(libraryIndex);
+    }
+
+    // The details are searchable too, so they can decide whether the video is shown
+    quint32 id = library->id(libraryIndex);
+    search.insert(id, searchText(libraryIndex));
+    if (!filter.isEmpty()) {
+        bool matching = search.matches(id, filter);
+        if (matching && rows[libraryIndex] < 0) {
+            showVideo(libraryIndex);
+        } else if (!matching && rows[libraryIndex] >= 0) {
+            hideVideo(libraryIndex);
+        }
+    }
+
+    if (rows[libraryIndex] >= 0) {
+        if (resort) {
+            resortVideo(libraryIndex);  // Now that its duration or play count is known, the row may belong elsewhere
+        }
+        QModelIndex changed = index(rows[libraryIndex]);
+        emit dataChanged(changed, changed, {ViewCountRole, DurationRole, ResolutionRole, VideoCodecRole});
+    }
+}
+
+void VideoListModel::setFilterText(const QString &text)
+{
+    QString simplified = text.simplified();
+    if (simplified == filter) {
+        return;
+    }
+
+    // Only the row order changes; the delegate paints whatever rows end up on screen
+    beginResetModel();
+    filter = simplified;
+    rebuildOrder();
+    endResetModel();
+}
+
+void VideoListModel::setSortOrder(MediaLibrary::SortOrder order)
+{
+    if (order == sorting) {
+        return;
+    }
+
+    // The only full sort: it compares the keys the library worked out up front, and is kept for filtering
+    beginResetModel();
+    sorting = order;
+    sorted = library->sortedIndices(sorting);
+    rebuildOrder();
+    endResetModel();
+}
+
+void VideoListModel::setThumbnail(const QString &fileName, const QPixmap &pixmap)
+{
+    int libraryIndex = library->indexOf(fileName);
+    if (libraryIndex < 0) {
+        return;  // The video has left the library since this thumbnail was requested
+    }
+
+    int cost = qMax(1, int(qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8 / 1024));
+    thumbnails.insert(fileName, new QPixmap(pixmap), cost);
+    if (rows[libraryIndex] >= 0) {
+        QModelIndex changed = index(rows[libraryIndex]);
+        emit dataChanged(changed, changed, {Qt::DecorationRole});
+    }
+}
+
+void VideoListModel::dropThumbnail(const QString &fileName)
+{
+    thumbnails.remove(fileName);
+
+    int libraryIndex = library->indexOf(fileName);
+    if (libraryIndex >= 0 && rows[libraryIndex] >= 0) {
+        QModelIndex changed = index(rows[libraryIndex]);
+        emit dataChanged(changed, changed, {Qt::DecorationRole});
+    }
+}
+
+void VideoListModel::clearThumbnails()
+{
+    thumbnails.clear();
+    if (rowCount() > 0) {
+        emit dataChanged(index(0), index(rowCount() - 1), {Qt::DecorationRole});
+    }
+}
+
+void VideoListModel::setThumbnailBudget(qint64 bytes)
+{
+    thumbnails.setMaxCost(int(qMax<qint64>(1, bytes / 1024)));
+}
+
+QString VideoListModel::searchText(int libraryIndex) const
+{
+    QString text = library->fileName(libraryIndex);
+    MediaLibrary::MediaInfo info = library->info(libraryIndex);
+    if (info.resolution.isValid()) {
+        text += QString(" %1x%2").arg(info.resolution.width()).arg(info.resolution.height());
+    }
+    if (!info.videoCodec.isEmpty()) {
+        text += QLatin1Char(' ') + info.videoCodec;
+    }
+    if (!info.audioCodec.isEmpty()) {
+        text += QLatin1Char(' ') + info.audioCodec;
+    }
+    return text;
+}
+
+void VideoListModel::rebuildOrder()
+{
+    int count = library->count();
+    order.clear();
+    rows.assign(count, -1);
+
+    // A keystroke in the search box only filters the sorted library; it never sorts
+    if (filter.isEmpty()) {
+        order = sorted;
+    } else {
+        // Mark the matches, then collect them in sort order
+        std::vector<char> matching(count, 0);
+        for (quint32 id : search.search(filter)) {
+            int entry = library->indexOfId(id);
+            if (entry >= 0) {
+                matching[entry] = 1;
+            }
+        }
+        for (int entry : sorted) {
+            if (matching[entry]) {
+                order.push_back(entry);
+            }
+        }
+    }
+    reindexRows(0);
+}
+
+void VideoListModel::unsortVideo(int libraryIndex)
+{
+    // Its key has not changed yet, so a binary search still finds it
+    auto position = std::lower_bound(sorted.begin(), sorted.end(), libraryIndex, [this](int entry, int video) {
+        return library->sortsBefore(sorting, entry, video);
+    });
+    sorted.erase(position);
+}
+
+void VideoListModel::sortVideo(int libraryIndex)
+{
+    auto position = std::lower_bound(sorted.begin(), sorted.end(), libraryIndex, [this](int entry, int video) {
+        return library->sortsBefore(sorting, entry, video);
+    });
+    sorted.insert(position, libraryIndex);
+}
+
+void VideoListModel::showVideo(int libraryIndex)
+{
+    auto position = std::lower_bound(order.begin(), order.end(), libraryIndex, [this](int entry, int video) {
+        return library->sortsBefore(sorting, entry, video);
+    });
+    int row = int(position - order.begin());
+    beginInsertRows(QModelIndex(), row, row);
+    order.insert(order.begin() + row, libraryIndex);
+    reindexRows(row);
+    endInsertRows();
+}
+
+void VideoListModel::showVideos(std::vector<int> libraryIndices)
+{
+    if (libraryIndices.empty()) {
+        return;
+    }
+    auto before = [this](int entry, int video) { return library->sortsBefore(sorting, entry, video); };
+    std::sort(libraryIndices.begin(), libraryIndices.end(), before);
+
+    // One merge pass gives the new order, and the runs of adjacent new rows in it
+    std::vector<int> merged;
+    merged.reserve(order.size() + libraryIndices.size());
+    std::vector<std::pair<int, int>> runs;  // First row and length of each run, top to bottom
+    size_t shown = 0;
+    size_t next = 0;
+    while (shown < order.size() || next < libraryIndices.size()) {
+        if (next < libraryIndices.size() && (shown == order.size() || before(libraryIndices[next], order[shown]))) {
+            if (runs.empty() || runs.back().first + runs.back().second != int(merged.size())) {
+                runs.emplace_back(int(merged.size()), 0);
+            }
+            runs.back().second++;
+            merged.push_back(libraryIndices[next++]);
+        } else {
+            merged.push_back(order[shown++]);
+        }
+    }
+
+    if (runs.size() <= size_t(maxInsertRuns)) {
+        // A few runs go in one insertion each, top to bottom, so each lands at its final row
+        for (const std::pair<int, int> &run : runs) {
+            beginInsertRows(QModelIndex(), run.first, run.first + run.second - 1);
+            order.insert(order.begin() + run.first, merged.begin() + run.first, merged.begin() + run.first + run.second);
+            endInsertRows();
+        }
+        reindexRows(runs.front().first);
+        return;
+    }
+
+    // New videos scattered all over the list: swap in the merged order as one layout change,
+    // with the selection and the other persistent indices following their videos
+    emit layoutAboutToBeChanged();
+    QModelIndexList persistent = persistentIndexList();
+    std::vector<int> persistentVideos;
+    persistentVideos.reserve(size_t(persistent.size()));
+    for (const QModelIndex &item : persistent) {
+        persistentVideos.push_back(order[item.row()]);
+    }
+    order.swap(merged);
+    reindexRows(0);
+    QModelIndexList moved;
+    for (int video : persistentVideos) {
+        moved.append(index(rows[video]));
+    }
+    changePersistentIndexList(persistent, moved);
+    emit layoutChanged();
+}
+
+void VideoListModel::resortVideo(int libraryIndex)
+{
+    int row = rows[libraryIndex];
+    bool afterPrevious = row == 0 || library->sortsBefore(sorting, order[row - 1], libraryIndex);
+    bool beforeNext = row + 1 == int(order.size()) || library->sortsBefore(sorting, libraryIndex, order[row + 1]);
+    if (afterPrevious && beforeNext) {
+        return;  // Still in place
+    }
+
+    // Find the new place among the other rows, then move the row there
+    order.erase(order.begin() + row);
+    auto position = std::lower_bound(order.begin(), order.end(), libraryIndex, [this](int entry, int video) {
+        return library->sortsBefore(sorting, entry, video);
+    });
+    int destination = int(position - order.begin());
+    order.insert(order.begin() + row, libraryIndex);
+
+    // Qt wants the destination as the row the moved one is inserted before, counted before the move
+    beginMoveRows(QModelIndex(), row, row, QModelIndex(), destination > row ? destination + 1 : destination);
+    order.erase(order.begin() + row);
+    order.insert(order.begin() + destination, libraryIndex);
+    reindexRows(qMin(row, destination));
+    endMoveRows();
+}
+
+void VideoListModel::hideVideo(int libraryIndex)
+{
+    int row = rows[libraryIndex];
+    beginRemoveRows(QModelIndex(), row, row);
+    order.erase(order.begin() + row);
+    rows[libraryIndex] = -1;
+    reindexRows(row);
+    endRemoveRows();
+}
+
+void VideoListModel::reindexRows(int fromRow)
+{
+    for (int row = fromRow; row < int(order.size()); ++row) {
+        rows[order[row]] = row;
+    }
+}
@@ -0,0 +1,127 @@
+#ifndef VIDEOLISTMODEL_H
+#define VIDEOLISTMODEL_H
+
+#include "mediaLibrary.h"
+#include "searchIndex.h"
+#include <QAbstractListModel>
+#include <QCache>
+#include <QPixmap>
+#include <vector>
+
+// VideoListModel exposes the MediaLibrary to the video list view. Every change to
+// the library goes through the model so the view only has to repaint the rows that
+// actually changed. Rows follow the selected sort order and a search filter can hide
+// videos, so rows and library indices are mapped both ways; the model's methods take
+// library indices unless they say otherwise.
+// Decoded thumbnails are kept in a cache bounded by a memory budget; rows whose
+// thumbnail has been evicted show the placeholder until ThumbnailPrefetcher loads it again.
+class VideoListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    // Extra data roles read by the list delegate and the player
+    enum Roles {
+        UrlRole = Qt::UserRole,        // QUrl of the video file
+        ViewCountRole,                 // View count shown under the title
+        DurationRole,                  // Duration in milliseconds, or -1 while unknown
+        ResolutionRole,                // Frame size; invalid while unknown
+        VideoCodecRole                 // Name of the video codec; empty while unknown
+    };
+
+    // Constructor: the model presents the given library, which must outlive it
+    VideoListModel(MediaLibrary *library, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // Empty the library and point it at a new folder
+    void resetLibrary(const QString &folderPath);
+
+    // Add a batch of scanned videos at their sorted positions. Returns the new library index
+    // of every video that was already there, by its old index.
+    std::vector<int> addVideos(const std::vector<MediaLibrary::ScannedVideo> &videos);
+
+    // Remove the video at the given library index
+    void removeVideo(int libraryIndex);
+
+    // Record a new size and modification time for the file of the video at the given library index
+    void setFileStamp(int libraryIndex, qint64 fileSize, qint64 modified);
+
+    // Record the technical details of the video at the given library index
+    void setInfo(int libraryIndex, const MediaLibrary::MediaInfo &info);
+
+    // Only show the videos whose name or details contain every word of the text; an empty text shows all
+    void setFilterText(const QString &text);
+    QString filterText() const { return filter; }
+
+    // Show the rows in the given order
+    void setSortOrder(MediaLibrary::SortOrder order);
+    MediaLibrary::SortOrder sortOrder() const { return sorting; }
+
+    // Library index of the video shown in the given row
+    int libraryIndex(int row) const { return order[row]; }
+
+    // Row showing the video at the given library index, or -1 while the filter hides it
+    int rowOf(int libraryIndex) const { return rows[libraryIndex]; }
+
+    // Show a decoded thumbnail in the row of the named video
+    void setThumbnail(const QString &fileName, const QPixmap &pixmap);
+
+    // Forget the thumbnail of the named video, e.g. because its file has changed
+    void dropThumbnail(const QString &fileName);
+
+    // Forget every thumbnail, e.g. because the list now shows them at another size
+    void clearThumbnails();
+
+    // Whether the thumbnail of the named video is resident
+    bool hasThumbnail(const QString &fileName) const { return thumbnails.contains(fileName); }
+
+    // Memory the resident thumbnails may use; the least recently shown ones are evicted beyond it
+    void setThumbnailBudget(qint64 bytes);
+    qint64 thumbnailBudget() const { return qint64(thumbnails.maxCost()) * 1024; }
+
+    // Thumbnail shown until a row's real one has been decoded
+    void setPlaceholder(const QPixmap &pixmap) { placeholder = pixmap; }
+
+private:
+    // Text the search looks at for the video at the given library index
+    QString searchText(int libraryIndex) const;
+
+    // Take a video out of the sorted library, before its sort key changes or it is removed
+    void unsortVideo(int libraryIndex);
+
+    // Put a video back into the sorted library at its place
+    void sortVideo(int libraryIndex);
+
+    // Work out which videos are shown, in sort order
+    void rebuildOrder();
+
+    // Insert the row of a video the filter now lets through at its sorted place
+    void showVideo(int libraryIndex);
+
+    // Insert the rows of several videos at their sorted places in one merge: a few runs of adjacent
+    // rows are inserted one run at a time, rows scattered all over the list as one layout change
+    void showVideos(std::vector<int> libraryIndices);
+
+    // Move the row of a video whose sort key has changed to its new place
+    void resortVideo(int libraryIndex);
+
+    // Remove the row of a video the filter now hides
+    void hideVideo(int libraryIndex);
+
+    // Point the library-to-row map at the rows from the given row onwards
+    void reindexRows(int fromRow);
+
+    MediaLibrary *library;              // The videos behind the rows
+    SearchIndex search;                 // Trigram index over the names and details of the videos
+    QString filter;                     // Current search text, simplified; empty shows everything
+    MediaLibrary::SortOrder sorting = MediaLibrary::SortByName; // Order of the rows
+    std::vector<int> sorted;            // Every library index in sort order, filtered or not; sorted once per sort order
+    std::vector<int> order;             // Library index shown in each row
+    std::vector<int> rows;              // Row of each library index, or -1 while filtered out
+    mutable QCache<QString, QPixmap> thumbnails; // Resident thumbnails by video file name; cost in KB, LRU on access
+    QPixmap placeholder;                // Shown for rows without a decoded thumbnail
+};
+
+#endif // VIDEOLISTMODEL_H